@@ -0,0 +1,139 @@
+/*
+ * Filename: bit_reader.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef BIT_READER_H_
+#define BIT_READER_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <vector>
+
+namespace huff
+{
+    // Quantidade mínima de bits disponíveis no acumulador após um Refill(), enquanto
+    // houver dados na entrada. Também é o maior código que pode ser lido com Peek()
+    constexpr uint8_t BIT_READER_MIN_BITS = 56;
+
+    /**
+     * @brief Leitor de bits empacotados
+     *
+     * Mantém os próximos bits da entrada alinhados à esquerda em um acumulador de 64
+     * bits, de modo que os próximos n bits são obtidos com um único deslocamento. O
+     * acumulador é recarregado com até 8 bytes de uma vez. A entrada pode ser um
+     * bloco de memória ou uma stream, lida em blocos de BUFFER_MAX_SIZE bytes. Depois
+     * do fim da entrada, os bits lidos são 0
+     **/
+    class BitReader
+    {
+        private:
+            std::istream*              m_stream;
+            std::vector<unsigned char> m_buffer;
+
+            const unsigned char* m_data;
+            std::size_t          m_size;
+            std::size_t          m_pos;
+
+            uint64_t m_accumulator;
+            uint8_t  m_numBits;  // Quantidade de bits válidos no acumulador
+            uint64_t m_consumed; // Total de bits consumidos
+
+            /**
+             * @brief Recarrega o acumulador byte a byte (fim do bloco de dados atual)
+             **/
+            void RefillSlow();
+
+            /**
+             * @brief Lê o próximo bloco de dados da stream
+             * @return Verdadeiro se algum byte foi lido
+             **/
+            bool Fetch();
+
+        public:
+            /**
+             * @brief Cria um leitor sem entrada, que retorna apenas 0s
+             **/
+            BitReader();
+
+            /**
+             * @brief Cria um leitor sobre um bloco de memória
+             * @param data Início do bloco
+             * @param size Tamanho do bloco em bytes
+             **/
+            BitReader(const unsigned char* data, std::size_t size);
+
+            /**
+             * @brief Cria um leitor que consome uma stream a partir da posição atual
+             * @param stream Stream que será lida
+             **/
+            BitReader(std::istream& stream);
+
+            /**
+             * @brief Garante ao menos BIT_READER_MIN_BITS bits no acumulador, exceto
+             *no fim da entrada
+             **/
+            inline void Refill();
+
+            /**
+             * @brief Retorna os próximos `length` bits sem consumi-los
+             * @param length Quantidade de bits (entre 1 e BIT_READER_MIN_BITS)
+             **/
+            inline uint64_t Peek(uint8_t length) const;
+
+            /**
+             * @brief Consome `length` bits
+             * @param length Quantidade de bits (no máximo a quantidade disponível)
+             **/
+            inline void Consume(uint8_t length);
+
+            /**
+             * @brief Quantidade de bits consumidos desde o início da leitura
+             **/
+            inline uint64_t GetPosition() const;
+    };
+
+    inline void BitReader::Refill()
+    {
+        if (this->m_pos + sizeof(this->m_accumulator) > this->m_size)
+        {
+            this->RefillSlow();
+            return;
+        }
+
+        // Lê 8 bytes de uma vez e completa o acumulador. Os bits do último byte que
+        // não couberem são lidos novamente na próxima recarga
+        uint64_t bytes;
+        std::memcpy(&bytes, this->m_data + this->m_pos, sizeof(bytes));
+
+        if constexpr (std::endian::native == std::endian::little)
+            bytes = __builtin_bswap64(bytes);
+
+        this->m_accumulator |= bytes >> this->m_numBits;
+        this->m_pos += (63 - this->m_numBits) >> 3;
+        this->m_numBits |= BIT_READER_MIN_BITS;
+    }
+
+    inline uint64_t BitReader::Peek(uint8_t length) const
+    {
+        return this->m_accumulator >> (64 - length);
+    }
+
+    inline void BitReader::Consume(uint8_t length)
+    {
+        this->m_accumulator <<= length;
+        this->m_numBits -= length;
+        this->m_consumed += length;
+    }
+
+    inline uint64_t BitReader::GetPosition() const
+    {
+        return this->m_consumed;
+    }
+} // namespace huff
+
+#endif // BIT_READER_H_
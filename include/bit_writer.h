@@ -0,0 +1,156 @@
+/*
+ * Filename: bit_writer.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef BIT_WRITER_H_
+#define BIT_WRITER_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+namespace huff
+{
+    // Quantidade máxima de bits aceita em uma única chamada interna de escrita.
+    // Códigos maiores são divididos em partes de, no máximo, esse tamanho
+    constexpr uint8_t BIT_WRITER_MAX_CHUNK = 32;
+
+    // Tamanho do acumulador de bits
+    constexpr uint8_t BIT_WRITER_ACCUMULATOR_SIZE = 64;
+
+    /**
+     * @brief Escritor de bits empacotados
+     *
+     * Os bits são acumulados em um inteiro de 64 bits (do mais significativo para o
+     * menos significativo, a mesma ordem usada no formato do binário) e, quando o
+     * acumulador enche, os bytes completos são copiados de uma só vez para um buffer
+     * de bytes. Quando associado a uma stream, o buffer é descarregado nela sempre que
+     * atinge BUFFER_MAX_SIZE; caso contrário, os bytes permanecem em memória e podem
+     * ser obtidos com GetData() e GetSize()
+     **/
+    class BitWriter
+    {
+        private:
+            std::ostream*              m_stream;
+            std::vector<unsigned char> m_buffer;
+            std::size_t                m_size; // Bytes válidos no buffer
+            std::size_t                m_flushThreshold;
+
+            uint64_t m_accumulator;
+            uint8_t  m_numBits; // Quantidade de bits pendentes no acumulador
+
+            /**
+             * @brief Move os bytes completos do acumulador para o buffer
+             **/
+            inline void Drain();
+
+            /**
+             * @brief Escreve o buffer de bytes na stream associada e o esvazia. Sem
+             *stream, aumenta o buffer
+             **/
+            void Commit();
+
+            /**
+             * @brief Escreve códigos com mais de BIT_WRITER_MAX_CHUNK bits
+             * @param bits Bits que serão escritos
+             * @param length Quantidade de bits
+             **/
+            void WriteLong(uint64_t bits, uint8_t length);
+
+        public:
+            /**
+             * @brief Cria um escritor que mantém os bytes em memória
+             **/
+            BitWriter();
+
+            /**
+             * @brief Cria um escritor que descarrega os bytes em uma stream
+             * @param stream Stream na qual os bytes serão escritos
+             **/
+            BitWriter(std::ostream& stream);
+
+            /**
+             * @brief Escreve os `length` bits menos significativos de `bits`
+             * @param bits Bits que serão escritos
+             * @param length Quantidade de bits (no máximo 64)
+             **/
+            inline void Write(uint64_t bits, uint8_t length);
+
+            /**
+             * @brief Completa o último byte para que a escrita fique alinhada
+             * @param fillWithOnes Se verdadeiro, completa com 1s. Caso contrário, com 0s
+             * @return Quantidade de bits usados para completar o byte
+             **/
+            uint8_t AlignToByte(bool fillWithOnes = false);
+
+            /**
+             * @brief Copia bytes para a saída. A escrita deve estar alinhada
+             * @param data Início dos bytes
+             * @param size Quantidade de bytes
+             **/
+            void WriteBytes(const unsigned char* data, std::size_t size);
+
+            /**
+             * @brief Descarrega os bytes completos na stream associada
+             *        Bits que ainda não formam um byte permanecem no acumulador
+             **/
+            void Flush();
+
+            /**
+             * @brief Bytes completos que ainda não foram descarregados
+             **/
+            const unsigned char* GetData() const;
+
+            /**
+             * @brief Quantidade de bytes completos que ainda não foram descarregados
+             **/
+            std::size_t GetSize() const;
+    };
+
+    inline void BitWriter::Drain()
+    {
+        if (this->m_numBits < 8)
+            return;
+
+        if (this->m_size + sizeof(this->m_accumulator) > this->m_buffer.size())
+            this->Commit();
+
+        // Alinha os bits pendentes à esquerda e copia os 8 bytes de uma vez. Apenas os
+        // bytes completos são contabilizados; o restante será sobrescrito
+        uint64_t bytes = this->m_accumulator
+                         << (BIT_WRITER_ACCUMULATOR_SIZE - this->m_numBits);
+
+        if constexpr (std::endian::native == std::endian::little)
+            bytes = __builtin_bswap64(bytes);
+
+        std::memcpy(this->m_buffer.data() + this->m_size, &bytes, sizeof(bytes));
+
+        this->m_size += this->m_numBits / 8;
+        this->m_numBits %= 8;
+
+        if (this->m_size >= this->m_flushThreshold)
+            this->Commit();
+    }
+
+    inline void BitWriter::Write(uint64_t bits, uint8_t length)
+    {
+        if (length > BIT_WRITER_MAX_CHUNK)
+        {
+            this->WriteLong(bits, length);
+            return;
+        }
+
+        if (this->m_numBits + length > BIT_WRITER_ACCUMULATOR_SIZE)
+            this->Drain();
+
+        this->m_accumulator = (this->m_accumulator << length) | bits;
+        this->m_numBits += length;
+    }
+} // namespace huff
+
+#endif // BIT_WRITER_H_
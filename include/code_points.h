@@ -0,0 +1,173 @@
+/*
+ * Filename: code_points.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef CODE_POINTS_H_
+#define CODE_POINTS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace huff
+{
+    // Quantidade de code points Unicode (U+0000 a U+10FFFF)
+    constexpr uint32_t CODE_POINT_LIMIT = 0x110000;
+
+    // Os bytes que não formam uma sequência UTF-8 completa dentro do bloco (por
+    // exemplo, o início e o fim de uma sequência dividida entre dois blocos) são
+    // símbolos próprios, representados por CODE_POINT_LIMIT mais o valor do byte
+    constexpr uint32_t CODE_POINT_ALPHABET_SIZE = CODE_POINT_LIMIT + 256;
+
+    // Os símbolos são indexados em dois níveis: páginas de 2^CODE_POINT_PAGE_BITS
+    // símbolos vizinhos, alocadas apenas quando algum símbolo da página aparece
+    constexpr uint8_t  CODE_POINT_PAGE_BITS = 8;
+    constexpr uint32_t CODE_POINT_PAGE_SIZE = uint32_t(1) << CODE_POINT_PAGE_BITS;
+    constexpr uint32_t CODE_POINT_NO_PAGE   = UINT32_MAX;
+
+    // Maior quantidade de símbolos distintos em um bloco codificado com o alfabeto de
+    // code points. Os símbolos são numerados com 16 bits na construção dos códigos e
+    // na decodificação
+    constexpr uint32_t CODE_POINT_MAX_SYMBOLS = uint32_t(1) << 16;
+
+    // Maior tamanho de uma sequência UTF-8
+    constexpr uint8_t UTF8_MAX_SEQUENCE = 4;
+
+    // Bytes que um símbolo do alfabeto de code points representa
+    struct SymbolBytes
+    {
+            unsigned char bytes[UTF8_MAX_SEQUENCE] = {};
+            uint8_t       length                   = 0;
+    };
+
+    /**
+     * @brief Lê o símbolo do alfabeto de code points que começa em `data`
+     *        Uma sequência UTF-8 completa e mínima é o seu code point; qualquer outro
+     *byte é um símbolo isolado. Assim, qualquer entrada é representada sem perdas
+     * @param data Início do símbolo
+     * @param size Quantidade de bytes disponíveis a partir de `data`, maior que 0
+     * @param symbol Símbolo lido
+     * @return Quantidade de bytes do símbolo
+     **/
+    inline std::size_t
+    NextSymbol(const unsigned char* data, std::size_t size, uint32_t& symbol)
+    {
+        unsigned char lead = data[0];
+
+        if (lead < 0x80)
+        {
+            symbol = lead;
+            return 1;
+        }
+
+        symbol = CODE_POINT_LIMIT + lead;
+
+        // Bytes de continuação e bytes iniciais que só formam codificações não
+        // mínimas (C0 e C1) ou valores acima de U+10FFFF (F5 a FF)
+        if (lead < 0xC2 or lead > 0xF4)
+            return 1;
+
+        auto continuation = [data](std::size_t i) { return (data[i] & 0xC0) == 0x80; };
+
+        if (lead < 0xE0)
+        {
+            if (size < 2 or not continuation(1))
+                return 1;
+
+            symbol = (lead & 0x1F) << 6 | (data[1] & 0x3F);
+            return 2;
+        }
+
+        if (lead < 0xF0)
+        {
+            if (size < 3 or not continuation(1) or not continuation(2))
+                return 1;
+
+            uint32_t codePoint =
+                (lead & 0x0F) << 12 | (data[1] & 0x3F) << 6 | (data[2] & 0x3F);
+
+            if (codePoint < 0x800)
+                return 1;
+
+            symbol = codePoint;
+            return 3;
+        }
+
+        if (size < 4 or not continuation(1) or not continuation(2) or
+            not continuation(3))
+            return 1;
+
+        uint32_t codePoint = (lead & 0x07) << 18 | (data[1] & 0x3F) << 12 |
+                             (data[2] & 0x3F) << 6 | (data[3] & 0x3F);
+
+        if (codePoint < 0x10000 or codePoint >= CODE_POINT_LIMIT)
+            return 1;
+
+        symbol = codePoint;
+        return 4;
+    }
+
+    /**
+     * @brief Bytes representados por um símbolo do alfabeto de code points
+     * @param symbol Símbolo, menor que CODE_POINT_ALPHABET_SIZE
+     **/
+    SymbolBytes ToBytes(uint32_t symbol);
+
+    /**
+     * @brief Contador de frequências dos símbolos do alfabeto de code points
+     *
+     * Um diretório indexado pelos bits mais significativos do símbolo aponta para
+     * páginas de CODE_POINT_PAGE_SIZE contadores, alocadas na primeira ocorrência de
+     * um símbolo da página. Os textos usam poucos intervalos do Unicode (um alfabeto e
+     * a pontuação ASCII, por exemplo), de modo que poucas páginas são alocadas e cada
+     * símbolo custa dois acessos à memória. Depois de List, os contadores passam a
+     * guardar o índice de cada símbolo, e o mesmo diretório serve para encontrar o
+     * código de cada símbolo na codificação
+     **/
+    class CodePointHistogram
+    {
+        private:
+            std::vector<uint32_t> m_directory; // Início de cada página em m_entries
+            std::vector<uint32_t> m_entries;   // Contadores ou índices das páginas
+
+        public:
+            CodePointHistogram();
+
+            /**
+             * @brief Descarta as contagens e as páginas alocadas
+             **/
+            void Clear();
+
+            /**
+             * @brief Contabiliza os símbolos de um bloco de memória
+             * @param data Início do bloco
+             * @param size Tamanho do bloco em bytes
+             **/
+            void Count(const unsigned char* data, std::size_t size);
+
+            /**
+             * @brief Lista os símbolos presentes em ordem crescente e substitui a
+             *contagem de cada um pelo seu índice na lista
+             * @param symbols Símbolos presentes
+             * @param frequencies Frequência de cada símbolo, indexada pelo índice
+             **/
+            void List(std::vector<uint32_t>&    symbols,
+                      std::vector<std::size_t>& frequencies);
+
+            /**
+             * @brief Índice de um símbolo contado, válido após List
+             * @param symbol Símbolo presente no bloco contado
+             **/
+            inline uint32_t Index(uint32_t symbol) const;
+    };
+
+    inline uint32_t CodePointHistogram::Index(uint32_t symbol) const
+    {
+        return this->m_entries[this->m_directory[symbol >> CODE_POINT_PAGE_BITS] +
+                               (symbol & (CODE_POINT_PAGE_SIZE - 1))];
+    }
+} // namespace huff
+
+#endif // CODE_POINTS_H_
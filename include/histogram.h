@@ -0,0 +1,57 @@
+/*
+ * Filename: histogram.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace huff
+{
+    // Quantidade de sub-histogramas intercalados
+    constexpr uint8_t HISTOGRAM_LANES = 4;
+
+    /**
+     * @brief Contador de frequências dos bytes
+     *
+     * Cada byte incrementa diretamente o contador indexado pelo seu valor. Bytes
+     * consecutivos são contados em sub-histogramas diferentes, de modo que sequências
+     * de bytes repetidos não incrementam o mesmo endereço em seguida (o que faria
+     * cada incremento esperar a escrita do anterior). Os sub-histogramas são somados
+     * apenas ao final da contagem
+     **/
+    class Histogram
+    {
+        private:
+            std::vector<std::size_t> m_lanes;
+
+        public:
+            Histogram();
+
+            /**
+             * @brief Contabiliza os bytes de um bloco de memória
+             * @param data Início do bloco
+             * @param size Tamanho do bloco em bytes
+             **/
+            void Count(const unsigned char* data, std::size_t size);
+
+            /**
+             * @brief Soma as contagens de outro histograma a este
+             * @param other Histograma que será somado
+             **/
+            void Add(const Histogram& other);
+
+            /**
+             * @brief Soma os sub-histogramas
+             * @param frequencies Frequência de cada byte, indexada pelo byte
+             **/
+            void Merge(std::vector<std::size_t>& frequencies) const;
+    };
+} // namespace huff
+
+#endif // HISTOGRAM_H_
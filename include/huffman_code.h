@@ -0,0 +1,187 @@
+/*
+ * Filename: huffman_code.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef HUFFMAN_CODE_H_
+#define HUFFMAN_CODE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bit_reader.h"
+#include "bit_writer.h"
+
+namespace huff
+{
+    // Bit do primeiro byte da tabela de comprimentos que indica o alfabeto de code
+    // points (ver code_points.h). Sem ele, o alfabeto é o de bytes
+    constexpr uint8_t CODE_POINT_TABLE_FLAG = 0x80;
+
+    // Bits da quantidade de símbolos da tabela do alfabeto de code points
+    constexpr uint8_t CODE_POINT_COUNT_BITS = 16;
+
+    // Código de Huffman empacotado: os `length` bits menos significativos de `bits`
+    struct Code
+    {
+            uint64_t bits   = 0;
+            uint8_t  length = 0;
+    };
+
+    // Associação entre um símbolo do alfabeto e o seu código
+    struct SymbolCode
+    {
+            uint16_t symbol = 0;
+            Code     code;
+    };
+
+    // Símbolo do alfabeto com a sua frequência
+    struct SymbolWeight
+    {
+            uint64_t weight = 0;
+            uint16_t symbol = 0;
+    };
+
+    /**
+     * @brief Lista os símbolos presentes em ordem crescente de frequência e, em caso
+     *de empate, de símbolo. Com um único símbolo presente, acrescenta um vizinho com
+     *frequência 0, para que nenhum código tenha 0 bits
+     * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
+     * @param sorted Símbolos ordenados. O vector é reaproveitado entre chamadas, o que
+     *evita alocações depois da primeira
+     **/
+    void SortSymbols(const std::vector<std::size_t>& frequencies,
+                     std::vector<SymbolWeight>&      sorted);
+
+    /**
+     * @brief Calcula os comprimentos dos códigos de Huffman diretamente sobre o vector
+     *ordenado, sem construir a árvore, usando o algoritmo in-place de Moffat e
+     *Katajainen. Depois da ordenação, o cálculo é linear e não aloca memória
+     * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
+     * @param sorted Espaço de trabalho, reaproveitado entre chamadas
+     * @param codes Código de cada símbolo, indexado pelo símbolo. Apenas o campo
+     *`length` é preenchido; os códigos devem ser atribuídos com AssignCanonicalCodes
+     **/
+    void ComputeCodeLengths(const std::vector<std::size_t>& frequencies,
+                            std::vector<SymbolWeight>&      sorted,
+                            std::vector<Code>&              codes);
+
+    /**
+     * @brief Atribui os códigos canônicos a partir dos comprimentos
+     *        Os símbolos são ordenados pelo comprimento do código e, em seguida, pelo
+     *próprio símbolo. Cada código é o anterior mais 1, deslocado para a esquerda
+     *sempre que o comprimento aumenta
+     * @param codes Código de cada símbolo, indexado pelo símbolo. Apenas o campo
+     *`length` é lido. Símbolos com comprimento 0 não fazem parte do alfabeto
+     * @return Falso se os comprimentos não formarem um código prefixo
+     **/
+    bool AssignCanonicalCodes(std::vector<Code>& codes);
+
+    /**
+     * @brief Recalcula os comprimentos dos códigos de modo que nenhum ultrapasse
+     *`maxLength` bits, usando o algoritmo package-merge. O resultado é o código prefixo
+     *ótimo dentre os que respeitam o limite
+     * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
+     * @param maxLength Comprimento máximo dos códigos
+     * @param codes Código de cada símbolo, indexado pelo símbolo. Os símbolos com
+     *comprimento diferente de 0 têm o comprimento recalculado; os códigos devem ser
+     *atribuídos novamente com AssignCanonicalCodes
+     * @return Falso se os símbolos não couberem em códigos de `maxLength` bits
+     **/
+    bool LimitCodeLengths(const std::vector<std::size_t>& frequencies,
+                          uint8_t                         maxLength,
+                          std::vector<Code>&              codes);
+
+    /**
+     * @brief Maior comprimento entre os códigos
+     * @param codes Código de cada símbolo, indexado pelo símbolo
+     **/
+    uint8_t MaxCodeLength(const std::vector<Code>& codes);
+
+    /**
+     * @brief Quantidade de bits necessária para codificar os símbolos
+     * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
+     * @param codes Código de cada símbolo, indexado pelo símbolo
+     **/
+    uint64_t EncodedBits(const std::vector<std::size_t>& frequencies,
+                         const std::vector<Code>&        codes);
+
+    /**
+     * @brief Escreve a tabela de comprimentos dos códigos
+     *
+     *        Formato (alfabeto de bytes):
+     *        - 1 byte: quantidade w de bits usada para cada comprimento
+     *        - 1 byte: quantidade de símbolos presentes no alfabeto menos 1
+     *        - Para cada símbolo presente, em ordem crescente: a distância até o
+     *          símbolo anterior (o primeiro é comparado a -1) em código gama de Elias,
+     *          seguida do comprimento do código em w bits. Símbolos vizinhos, comuns
+     *          em textos, custam 1 bit além do comprimento
+     *        - Completado com 0s até o fim do byte
+     * @param writer Escritor de bits, alinhado em um byte
+     * @param codes Código de cada símbolo, indexado pelo símbolo
+     **/
+    void WriteCodeLengths(BitWriter& writer, const std::vector<Code>& codes);
+
+    /**
+     * @brief Escreve a tabela de comprimentos dos códigos do alfabeto de code points
+     *
+     *        O formato é o mesmo do alfabeto de bytes, exceto que o primeiro byte
+     *        contém também CODE_POINT_TABLE_FLAG e a quantidade de símbolos menos 1
+     *        ocupa CODE_POINT_COUNT_BITS bits
+     * @param writer Escritor de bits, alinhado em um byte
+     * @param codes Código de cada símbolo, indexado pelo índice do símbolo
+     * @param symbols Símbolos em ordem crescente, indexados pelo índice
+     **/
+    void WriteCodeLengths(BitWriter&                   writer,
+                          const std::vector<Code>&     codes,
+                          const std::vector<uint32_t>& symbols);
+
+    /**
+     * @brief Tamanho em bits da tabela escrita por WriteCodeLengths, incluindo o
+     *preenchimento do último byte
+     * @param codes Código de cada símbolo, indexado pelo símbolo
+     **/
+    uint64_t CodeLengthsBits(const std::vector<Code>& codes);
+
+    /**
+     * @brief Tamanho em bits da tabela do alfabeto de code points, incluindo o
+     *preenchimento do último byte
+     * @param codes Código de cada símbolo, indexado pelo índice do símbolo
+     * @param symbols Símbolos em ordem crescente, indexados pelo índice
+     **/
+    uint64_t CodeLengthsBits(const std::vector<Code>&     codes,
+                             const std::vector<uint32_t>& symbols);
+
+    /**
+     * @brief Lê a tabela de comprimentos escrita por WriteCodeLengths e atribui os
+     *códigos canônicos. Apenas o alfabeto de bytes é aceito
+     * @param reader Leitor de bits, alinhado em um byte
+     * @param codes Código de cada símbolo, indexado pelo símbolo
+     * @return Falso se a tabela for inválida
+     **/
+    bool ReadCodeLengths(BitReader& reader, std::vector<Code>& codes);
+
+    /**
+     * @brief Lê uma tabela de comprimentos de qualquer um dos alfabetos e atribui os
+     *códigos canônicos
+     * @param reader Leitor de bits, alinhado em um byte
+     * @param codes Código de cada símbolo, indexado pelo símbolo no alfabeto de bytes
+     *e pelo índice do símbolo no alfabeto de code points
+     * @param symbols Símbolos do alfabeto de code points, indexados pelo índice. Vazio
+     *se a tabela for do alfabeto de bytes
+     * @return Falso se a tabela for inválida
+     **/
+    bool ReadCodeLengths(BitReader&             reader,
+                         std::vector<Code>&     codes,
+                         std::vector<uint32_t>& symbols);
+
+    /**
+     * @brief Lista os símbolos que fazem parte do alfabeto com os seus códigos
+     * @param codes Código de cada símbolo, indexado pelo símbolo
+     **/
+    std::vector<SymbolCode> ListCodes(const std::vector<Code>& codes);
+} // namespace huff
+
+#endif // HUFFMAN_CODE_H_
@@ -7,7 +7,7 @@
 #ifndef HUFFMAN_COMPRESS_H_
 #define HUFFMAN_COMPRESS_H_
 
-#include <bitset>
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -16,27 +16,65 @@
 #include <fstream>
 #include <ios>
 #include <string>
+#include <thread>
 
-#include "binary_tree.h"
+#include "bit_reader.h"
+#include "bit_writer.h"
+#include "code_points.h"
+#include "histogram.h"
+#include "huffman_code.h"
 #include "huffman_compress_excpt.h"
-#include "map.h"
+#include "huffman_decoder.h"
+#include "huffman_tree.h"
+#include "input_file.h"
+#include "metrics.h"
+#include "perf_counters.h"
 #include "parser.h"
-#include "priority_queue_bheap.h"
-#include "vector.h"
+#include "utf8_validator.h"
 
-// Máscaras UTF-8
-constexpr uint8_t ONE_BYTE_UTF8_MASK   = 0x00; // 00000000
-constexpr uint8_t TWO_BYTE_UTF8_MASK   = 0xC0; // 11000000
-constexpr uint8_t THREE_BYTE_UTF8_MASK = 0xE0; // 11100000
-constexpr uint8_t FOUR_BYTE_UTF8_MASK  = 0xF0; // 11110000
-constexpr uint8_t BYTE_MASK            = 0xFF; // 11111111
+constexpr uint8_t BYTE_MASK = 0xFF; // 11111111
 
 // Assinatura do arquivo comprimido
 inline constexpr std::string_view SIGNATURE = "HUFF";
+// Assinatura do arquivo comprimido com códigos canônicos
+inline constexpr std::string_view CANONICAL_SIGNATURE = "HUFC";
+// Assinatura do arquivo comprimido em blocos
+inline constexpr std::string_view BLOCK_SIGNATURE = "HUFB";
+// Assinatura do arquivo comprimido em blocos com os códigos em fluxos intercalados
+inline constexpr std::string_view INTERLEAVED_SIGNATURE = "HUFI";
+
+// Nome que representa a entrada e a saída padrão
+inline constexpr std::string_view STREAM_NAME = "-";
 
 constexpr uint32_t BUFFER_MAX_SIZE = 1024 * 16; // 16 kB
 constexpr uint8_t  BYTE_SIZE       = 8;         // Um byte, oito bits
 
+// Cada símbolo do alfabeto é um byte, identificado pelo seu valor (0 a 255)
+constexpr uint16_t ALPHABET_SIZE = 256;
+
+// Menor limite aceito para o comprimento dos códigos, suficiente para todo o alfabeto
+constexpr uint8_t MIN_CODE_LENGTH = 8;
+
+// Tamanho dos blocos do formato em blocos
+constexpr uint32_t BLOCK_MIN_SIZE     = 1024 * 128;      // 128 kB
+constexpr uint32_t BLOCK_MAX_SIZE     = 1024 * 1024 * 4; // 4 MB
+constexpr uint32_t BLOCK_DEFAULT_SIZE = 1024 * 1024;     // 1 MB
+// Tamanho de cada campo numérico do formato em blocos
+constexpr uint8_t BLOCK_FIELD_SIZE_IN_BYTES = 4;
+
+// Tamanho de cada parte do arquivo contada por uma thread no cálculo das frequências
+// e codificada por uma thread nos formatos com uma única tabela
+constexpr uint64_t FREQUENCIES_CHUNK_SIZE = 1024 * 1024 * 8; // 8 MB
+// Tamanho de cada leitura feita dentro de uma parte
+constexpr uint32_t FREQUENCIES_READ_SIZE  = 1024 * 1024;     // 1 MB
+
+// Tamanho de cada parte do payload decodificada por uma thread na descompressão
+// paralela dos formatos com uma única tabela
+constexpr uint64_t SPECULATIVE_CHUNK_SIZE = 1024 * 1024 * 2; // 2 MB
+// Quantidade de símbolos do início de cada parte cujas posições são guardadas para
+// encontrar o ponto em que a decodificação da parte anterior a alcança
+constexpr uint32_t SPECULATIVE_SYNC_SYMBOLS = 4096;
+
 // Todo binário resultante da compressão de um arquivo contém um header.
 // O tamanho total do header é variável, pois depende da codificação da trie necessária
 // para descompactar o binário.
@@ -49,63 +87,143 @@ constexpr uint8_t  BYTE_SIZE       = 8;         // Um byte, oito bits
 //     com 0s ou 1s
 // 3 bytes para representar o tamanho total do cabeçalho
 //   - Utilizado para saber até qual byte do binário o cabeçalho se estende
+//
+// No formato legado (assinatura SIGNATURE), o restante do cabeçalho é a trie
+// serializada em pré-ordem. No formato canônico (assinatura CANONICAL_SIGNATURE), é
+// a tabela de comprimentos dos códigos (ver WriteCodeLengths), a partir da qual os
+// códigos canônicos são reconstruídos sem a necessidade de uma árvore
+//
+// O formato em blocos (assinatura BLOCK_SIGNATURE) não usa o cabeçalho acima. Após a
+// assinatura, há o tamanho máximo dos blocos, seguido dos blocos. Cada bloco é
+// independente e contém:
+// 4 bytes com a quantidade de bytes do arquivo original contidos no bloco
+// 4 bytes com o tamanho do restante do bloco
+// A tabela de comprimentos dos códigos canônicos do bloco (ver WriteCodeLengths)
+// Os códigos dos símbolos do bloco, com o último byte completado com 1s
+//
+// Os símbolos de cada bloco são os bytes ou, em blocos de texto, os code points
+// (ver code_points.h), o que resultar no bloco menor. O alfabeto é indicado pela
+// tabela de comprimentos
+//
+// O formato intercalado (assinatura INTERLEAVED_SIGNATURE) tem a mesma estrutura, mas
+// os códigos de cada bloco são divididos em INTERLEAVED_STREAMS fluxos independentes:
+// o código do i-ésimo símbolo do bloco fica no fluxo i % INTERLEAVED_STREAMS. Após a
+// tabela de comprimentos, há o tamanho em bytes de cada fluxo, exceto o do último,
+// que ocupa o restante do bloco. Cada fluxo tem o último byte completado com 1s
+//
+// Um bloco com os dois tamanhos iguais a 0 marca o fim do arquivo. Todos os campos
+// numéricos são gravados do byte mais significativo para o menos significativo
 
 constexpr uint8_t HEADER_RESERVED_BYTES_AT_START = 4;
 constexpr uint8_t HEADER_SIZE_IN_BYTES           = 3;
 
 namespace huff
 {
-    class TrieInfo
+    // Formatos do arquivo comprimido
+    enum class Format : uint8_t
     {
-        private:
-            std::size_t m_frequencie;
-            std::string m_bits;
+        LEGACY,      // Cabeçalho com a trie serializada
+        CANONICAL,   // Cabeçalho com a tabela de comprimentos dos códigos canônicos
+        BLOCK,       // Blocos independentes, cada um com a sua tabela de comprimentos
+        INTERLEAVED, // Blocos com os códigos divididos em fluxos independentes
+    };
 
-        public:
-            TrieInfo(const std::string bits, const std::size_t frequecie)
-                : m_bits(bits),
-                  m_frequencie(frequecie)
-            { }
+    // Configurações do compressor
+    struct Options
+    {
+            // Quantidade de threads usadas nas etapas paralelas
+            unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
 
-            std::size_t GetFrequencie() const
-            {
-                return m_frequencie;
-            }
+            // Formato do arquivo gerado pela compressão. O legado continua sendo o
+            // padrão, lido por todas as versões do programa
+            Format format = Format::LEGACY;
 
-            std::string GetBits() const
-            {
-                return m_bits;
-            }
+            // Tamanho máximo de cada bloco do formato em blocos
+            uint32_t blockSize = BLOCK_DEFAULT_SIZE;
 
-            // Função amiga para o overload do operador <<
-            friend std::ostream& operator<<(std::ostream& os, const TrieInfo& trieInfo)
-            {
-                os << "Bits: " << trieInfo.m_bits
-                   << ", Frequencie: " << trieInfo.m_frequencie;
-                return os;
-            }
+            // Maior comprimento permitido para um código. Por padrão, o maior código
+            // que o decodificador consegue ler
+            uint8_t maxCodeLength = BIT_READER_MIN_BITS;
+
+            // Aceita qualquer entrada (logs com bytes soltos, registros binários):
+            // cada byte é um símbolo e a validação UTF-8 não é feita
+            bool binary = false;
+
+            // Mede os contadores de hardware de cada fase. Sem efeito se o programa
+            // for compilado sem HUFF_PERF_COUNTERS
+            bool perfCounters = false;
     };
 
     class Compress
     {
         private:
-            rbtree::Map<std::string, std::string> m_map;
+            // Posição e tamanhos de um bloco do formato em blocos
+            struct BlockEntry
+            {
+                    uint64_t offset         = 0; // Início do conteúdo do bloco
+                    uint32_t rawSize        = 0;
+                    uint32_t compressedSize = 0;
+            };
+
+            Options m_options;
+
+            // Código de cada símbolo, indexado pelo próprio símbolo
+            std::vector<Code> m_codeTable;
+
+            // Símbolos ordenados pela frequência, reaproveitados a cada construção
+            std::vector<SymbolWeight> m_sorted;
+
+            // Frequências e índices dos code points do bloco atual, e os code points
+            // presentes em ordem crescente
+            CodePointHistogram    m_codePoints;
+            std::vector<uint32_t> m_symbols;
+
+            HuffmanTree m_trie;
 
-            BinaryTree<TrieInfo> m_trie;
+            // Medições da última compressão ou descompressão
+            Metrics m_metrics;
+
+            // Início e contadores da fase em andamento
+            std::chrono::high_resolution_clock::time_point m_phaseStart;
+            PerfCounters                                   m_counters;
+
+            // Acesso às etapas internas pelo microbenchmark (test/benchmark/bench.cc)
+            friend class Benchmark;
+
+            /**
+             * @brief Calcula a frequência de ocorrências de cada caractere do arquivo
+             *        O arquivo é dividido em partes de FREQUENCIES_CHUNK_SIZE bytes,
+             *contadas em paralelo por até m_options.numThreads threads, cada uma em
+             *um histograma próprio. Os histogramas são somados ao final. Sem
+             *mapeamento em memória, o arquivo é lido sequencialmente. Cada trecho
+             *contado é validado como UTF-8 logo em seguida, enquanto ainda está na
+             *cache
+             * @param input Arquivo que será utilizado no cálculo
+             * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
+             * @param validator Validação UTF-8 do arquivo, ainda não concluída
+             * @param chunkFrequencies Frequências de cada parte do arquivo, usadas na
+             *codificação paralela. Fica vazio sem o mapeamento em memória
+             **/
+            void Frequencies(InputFile&                             input,
+                             std::vector<std::size_t>&              frequencies,
+                             UTF8Validator&                         validator,
+                             std::vector<std::vector<std::size_t>>& chunkFrequencies);
 
             /**
-             * @brief Calcula a frequência de ocorrências de cada caractere da string
-             * @param string String que será utilizada no cálculo
-             * @param map Map com as frequências de cada caractere
+             * @brief Constroi a Trie de Huffman pelo método das duas filas: as folhas
+             *são criadas em ordem crescente de frequência e os nós internos, que surgem
+             *também em ordem crescente, ocupam as posições seguintes da arena. Assim,
+             *cada combinação escolhe os dois menores entre o início das duas filas
+             * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
              **/
-            void Frequencies(std::ifstream&                         string,
-                             rbtree::Map<std::string, std::size_t>& map);
+            void BuildTrie(const std::vector<std::size_t>& frequencies);
 
             /**
-             * @brief Constroi a Trie de Huffman
-             * @param map Map com as frequências de cada caractere
+             * @brief Calcula apenas os comprimentos dos códigos, sem construir a trie.
+             *Usado pelos formatos que gravam a tabela de comprimentos
+             * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
              **/
-            void BuildTrie(rbtree::Map<std::string, std::size_t>& map);
+            void BuildCodeLengths(const std::vector<std::size_t>& frequencies);
 
             /**
              * @brief Cria o código dos caracteres
@@ -114,72 +232,299 @@ namespace huff
 
             /**
              * @brief Cria o código dos caracteres (chamada recursiva)
-             * @param node Nó atual
+             * @param node Índice do nó atual
              * @param code Código até o momento
              **/
-            void BuildCode(dlkd::Node<TrieInfo>* node, std::string code);
+            void BuildCode(uint16_t node, Code code);
 
             /**
-             * @brief Escreve os bits no arquivo
-             * @param file Arquivo que será escrito
-             * @param buffer Buffer com os bits que serão gravados
+             * @brief Limita o comprimento dos códigos a m_options.maxCodeLength bits,
+             *caso a trie gere códigos mais longos. Os códigos passam a ser canônicos e,
+             *no formato legado, a trie é reconstruída a partir deles
+             * @param frequencies Frequência de cada símbolo, indexada pelo símbolo
+             * @return Quantidade de bits acrescentados ao payload pelo limite
              **/
-            void WriteBuffer(std::ofstream& file, std::string& buffer);
+            uint64_t LimitCode(const std::vector<std::size_t>& frequencies);
+
+            /**
+             * @brief Reconstroí a trie a partir dos códigos de m_codeTable
+             **/
+            void BuildTrieFromCode();
 
             /**
              * @brief Escreve os dados para a decodificação no cabeçalho do arquivo
              *binário
              * @param file Arquivo no qual ocorrerá a escrita
+             * @param writer Escritor de bits associado ao arquivo
              **/
-            std::streampos WriteHeader(std::ofstream& file);
+            std::streampos WriteHeader(std::ofstream& file, BitWriter& writer);
 
             /**
-             * @brief Lê o cabeçalho do arquivo binário
-             * @param file Arquivo binário que será lido
+             * @brief Lê o cabeçalho do arquivo binário e reconstroí os códigos
+             * @param file Arquivo binário posicionado após a assinatura
+             * @param format Formato indicado pela assinatura
+             * @param filename Nome do arquivo binário
              * @return Quantos bits do último byte do arquivo são inválidos
              **/
-            std::size_t ReadHeader(std::ifstream& file, std::string filename);
+            std::size_t
+            ReadHeader(std::istream& file, Format format, std::string filename);
 
             /**
              * @brief Escreve a informação para a reconstrução da árvore no arquivo
              *binário
-             * @param file Arquivo no qual ocorrerá a escrita
-             * @param node Nó atual da chamada recursiva
-             * @param buffer Buffer com os bits que serão gravados
+             * @param writer Escritor de bits no qual ocorrerá a escrita
+             * @param node Índice do nó atual da chamada recursiva
              **/
-            void WriteTrie(std::ofstream&        file,
-                           dlkd::Node<TrieInfo>* node,
-                           std::string&          buffer);
+            void WriteTrie(BitWriter& writer, uint16_t node);
 
             /**
              * @brief Reconstroí a trie a partir das informações gravadas no arquivo
              *binário
-             * @param file Arquivo binário que será lido
-             * @param headerData Vector com os bits do cabeçalho do arquivo
-             * @param pos Posição atual no vector
-             * @param numNodes Número de nós atualmente na árvore
+             * @param reader Leitor posicionado no próximo nó do cabeçalho
+             * @param headerBits Tamanho do cabeçalho em bits
+             * @param depth Profundidade do nó
+             * @return Índice do nó, ou TREE_NULL se o cabeçalho estiver incompleto
+             **/
+            uint16_t
+            RebuildTrie(BitReader& reader, uint64_t headerBits, uint16_t depth);
+
+            /**
+             * @brief Inicia a medição de uma fase
+             **/
+            void StartPhase();
+
+            /**
+             * @brief Encerra a medição iniciada por StartPhase() e a soma a m_metrics
+             * @param phase Fase medida
+             **/
+            void EndPhase(Phase phase);
+
+            /**
+             * @brief Comprime o arquivo com uma única tabela de códigos (formatos
+             *legado e canônico). O arquivo é lido duas vezes: no cálculo das
+             *frequências e na codificação
+             * @param filename Nome do arquivo que será comprimido
+             * @param input Arquivo que será comprimido
+             * @param output Arquivo binário no qual ocorrerá a escrita
+             **/
+            void EncodeSingleTable(std::string    filename,
+                                   InputFile&     input,
+                                   std::ofstream& output);
+
+            /**
+             * @brief Codifica o payload de um arquivo mapeado em paralelo, com o mesmo
+             *resultado da codificação sequencial. O tamanho de cada parte codificada é
+             *conhecido antes da codificação: é a soma das frequências da parte
+             *multiplicadas pelos comprimentos dos códigos. As somas acumuladas dão a
+             *posição, em bits, do início de cada parte no payload. Cada thread
+             *codifica uma parte a partir do deslocamento dessa posição dentro do seu
+             *byte, e os bytes divididos entre duas partes são unidos na escrita
+             * @param data Início do arquivo
+             * @param size Tamanho do arquivo em bytes
+             * @param chunkFrequencies Frequências de cada parte de
+             *FREQUENCIES_CHUNK_SIZE bytes do arquivo
+             * @param output Stream na qual ocorrerá a escrita
+             * @return Quantidade de bits completados com 1s no último byte
+             **/
+            uint8_t
+            EncodeChunks(const unsigned char*                         data,
+                         uint64_t                                     size,
+                         const std::vector<std::vector<std::size_t>>& chunkFrequencies,
+                         std::ostream&                                output) const;
+
+            /**
+             * @brief Comprime o arquivo no formato em blocos. Os blocos são
+             *comprimidos em paralelo por m_options.numThreads threads e escritos na
+             *ordem original. Cada byte do arquivo é lido uma única vez: o bloco é
+             *contado e codificado a partir da mesma cópia em memória, que é liberada em
+             *seguida. O binário é escrito em sequência, sem voltar a posição de
+             *escrita, e pode ser a saída padrão. A validação UTF-8 de cada bloco é
+             *unida à dos anteriores na ordem de escrita
+             * @param filename Nome do arquivo que será comprimido
+             * @param input Arquivo que será comprimido
+             * @param output Stream na qual ocorrerá a escrita
              **/
-            dlkd::Node<TrieInfo>* RebuildTrie(std::ifstream& file,
-                                              Vector<bool>&  headerData,
-                                              std::size_t&   pos,
-                                              std::size_t&   numNodes);
+            void EncodeBlocks(std::string   filename,
+                              InputFile&    input,
+                              std::ostream& output);
+
+            /**
+             * @brief Calcula os comprimentos dos códigos do bloco com o alfabeto de
+             *code points e os mantém em m_codeTable se o bloco ficar menor do que com
+             *o alfabeto de bytes, cujos códigos já estão em m_codeTable. O custo de
+             *cada alfabeto é o tamanho dos códigos somado ao da tabela de comprimentos
+             * @param frequencies Frequência de cada byte, trocada pela frequência de
+             *cada code point se esse alfabeto for escolhido
+             * @param codePointFrequencies Frequência de cada símbolo de m_symbols
+             * @return Verdadeiro se o alfabeto de code points for escolhido
+             **/
+            bool ChooseCodePoints(std::vector<std::size_t>& frequencies,
+                                  std::vector<std::size_t>& codePointFrequencies);
+
+            /**
+             * @brief Escreve os códigos dos símbolos de um bloco com os códigos de
+             *m_codeTable. O código do i-ésimo símbolo é escrito em
+             *writers[i % NUM_STREAMS]
+             * @param data Início do bloco
+             * @param size Tamanho do bloco em bytes
+             * @param codePoints Se verdadeiro, os símbolos são os code points
+             * @param writers NUM_STREAMS escritores
+             **/
+            template <uint8_t NUM_STREAMS>
+            void EncodeSymbols(const unsigned char* data,
+                               std::size_t          size,
+                               bool                 codePoints,
+                               BitWriter*           writers);
+
+            /**
+             * @brief Comprime um bloco: tabela de comprimentos seguida dos códigos,
+             *divididos em fluxos no formato intercalado. As medições do bloco são
+             *somadas a m_metrics
+             * @param data Início do bloco
+             * @param size Tamanho do bloco em bytes
+             * @param writer Escritor de bits no qual o bloco será escrito
+             * @param validator Validação UTF-8 do bloco, feita junto com a contagem
+             **/
+            void EncodeBlock(const unsigned char* data,
+                             std::size_t          size,
+                             BitWriter&           writer,
+                             UTF8Validator&       validator);
+
+            /**
+             * @brief Descomprime um arquivo com uma única tabela de códigos (formatos
+             *legado e canônico). Com mais de uma thread, o payload é decodificado por
+             *DecodeSpeculative
+             * @param input Arquivo binário posicionado após a assinatura
+             * @param format Formato indicado pela assinatura
+             * @param output Stream na qual ocorrerá a escrita
+             * @param filename Nome do arquivo binário
+             **/
+            void DecodeSingleTable(InputFile&    input,
+                                   Format        format,
+                                   std::ostream& output,
+                                   std::string   filename);
+
+            /**
+             * @brief Decodifica o payload de um arquivo com uma única tabela em
+             *paralelo. O payload é dividido em partes de SPECULATIVE_CHUNK_SIZE bytes,
+             *decodificadas ao mesmo tempo a partir do seu início, que pode estar no
+             *meio de um código. Os códigos de Huffman se sincronizam sozinhos: após
+             *alguns símbolos, a decodificação especulativa passa por uma posição em
+             *que um código realmente começa e, a partir dela, coincide com a
+             *decodificação sequencial. A decodificação correta da parte anterior
+             *continua até encontrar uma dessas posições, e as saídas são unidas nela.
+             *Se as decodificações não se encontrarem, a parte é decodificada
+             *novamente a partir do fim da anterior
+             * @param decoder Decodificador da tabela do arquivo
+             * @param payload Início do payload
+             * @param payloadBytes Tamanho do payload em bytes
+             * @param payloadBits Quantidade de bits válidos do payload
+             * @param output Stream na qual ocorrerá a escrita
+             * @param numSymbols Quantidade de símbolos decodificados
+             * @return Falso se o payload contiver um código inválido
+             **/
+            bool DecodeSpeculative(const HuffmanDecoder& decoder,
+                                   const unsigned char*  payload,
+                                   uint64_t              payloadBytes,
+                                   uint64_t              payloadBits,
+                                   std::ostream&         output,
+                                   uint64_t&             numSymbols) const;
+
+            /**
+             * @brief Descomprime um arquivo no formato em blocos ou no intercalado.
+             *Os blocos são descomprimidos em paralelo por até m_options.numThreads
+             *threads e escritos na ordem original. Sem o mapeamento (pipes), os blocos
+             *são lidos em sequência, sem voltar a posição de leitura
+             * @param input Arquivo binário posicionado após a assinatura
+             * @param format Formato indicado pela assinatura
+             * @param output Stream na qual ocorrerá a escrita
+             * @param filename Nome do arquivo binário
+             **/
+            void DecodeBlocks(InputFile&    input,
+                              Format        format,
+                              std::ostream& output,
+                              std::string   filename);
+
+            /**
+             * @brief Lê os campos de tamanho de todos os blocos, sem ler o conteúdo
+             * @param bin Arquivo binário posicionado no primeiro bloco
+             * @param blockSize Tamanho máximo dos blocos
+             * @param directory Posição e tamanhos de cada bloco
+             * @return Falso se algum campo for inválido ou o marcador de fim não for
+             *encontrado
+             **/
+            static bool ReadBlockDirectory(std::istream&            bin,
+                                           uint32_t                 blockSize,
+                                           std::vector<BlockEntry>& directory);
+
+            /**
+             * @brief Descomprime um bloco
+             * @param data Início do bloco, após os campos de tamanho
+             * @param size Tamanho do bloco em bytes
+             * @param format Formato do arquivo: em blocos ou intercalado
+             * @param output Região na qual os bytes decodificados serão escritos
+             * @param rawSize Quantidade de bytes decodificados do bloco
+             * @param tableBits Tamanho da tabela de comprimentos e, no formato
+             *intercalado, dos tamanhos dos fluxos em bits
+             * @param payloadBits Tamanho dos códigos decodificados em bits
+             * @param numSymbols Quantidade de símbolos decodificados
+             * @return Falso se o bloco estiver corrompido
+             **/
+            bool DecodeBlock(const unsigned char* data,
+                             std::size_t          size,
+                             Format               format,
+                             unsigned char*       output,
+                             std::size_t          rawSize,
+                             uint64_t&            tableBits,
+                             uint64_t&            payloadBits,
+                             uint64_t&            numSymbols) const;
+
+            /**
+             * @brief Maior tamanho possível de um bloco comprimido
+             * @param rawSize Quantidade de bytes do arquivo original contidos no bloco
+             **/
+            static uint64_t BlockBound(uint32_t rawSize);
+
+            /**
+             * @brief Escreve um campo numérico do formato em blocos
+             * @param output Stream na qual ocorrerá a escrita
+             * @param value Valor do campo
+             **/
+            static void WriteBlockField(std::ostream& output, uint32_t value);
+
+            /**
+             * @brief Lê um campo numérico do formato em blocos
+             * @param input Stream que será lida
+             * @param value Valor do campo
+             * @return Falso se a stream terminar antes do fim do campo
+             **/
+            static bool ReadBlockField(std::istream& input, uint32_t& value);
 
         public:
             Compress();
 
+            Compress(const Options& options);
+
             ~Compress();
 
             /**
-             * @brief Realiza a compressão do arquivo
+             * @brief Realiza a compressão do arquivo. Com o nome "-", lê da entrada
+             *padrão e escreve o binário na saída padrão
              * @param file Arquivo que será comprimido
              **/
             void Encode(std::string file);
 
             /**
-             * @brief Realiza a descompressão do arquivo
+             * @brief Realiza a descompressão do arquivo. Com o nome "-", lê da entrada
+             *padrão e escreve o resultado na saída padrão
              * @param file Arquivo que será descomprimido
              **/
             void Decode(std::string file);
+
+            /**
+             * @brief Medições da última compressão ou descompressão
+             **/
+            const Metrics& GetMetrics() const;
     };
 } // namespace huff
 
@@ -7,6 +7,7 @@
 #ifndef HUFFMAN_COMPRESS_EXCPT_H_
 #define HUFFMAN_COMPRESS_EXCPT_H_
 
+#include <cstdint>
 #include <exception>
 #include <string>
 
@@ -29,7 +30,7 @@ namespace huffexcpt
             std::string m_msg;
 
         public:
-            IsNotUTF8Encoding(std::string file);
+            IsNotUTF8Encoding(std::string file, uint64_t offset);
 
             const char* what() const throw();
     };
@@ -56,6 +57,39 @@ namespace huffexcpt
             const char* what() const throw();
     };
 
+    class CorruptedFile : public std::exception
+    {
+        private:
+            std::string m_msg;
+
+        public:
+            CorruptedFile(std::string file);
+
+            const char* what() const throw();
+    };
+
+    class InputNotSeekable : public std::exception
+    {
+        private:
+            std::string m_msg;
+
+        public:
+            InputNotSeekable(std::string file);
+
+            const char* what() const throw();
+    };
+
+    class InvalidMaxCodeLength : public std::exception
+    {
+        private:
+            std::string m_msg;
+
+        public:
+            InvalidMaxCodeLength(unsigned maxCodeLength);
+
+            const char* what() const throw();
+    };
+
 } // namespace huffexcpt
 
 #endif // HUFFMAN_COMPRESS_EXCPT_H_
@@ -0,0 +1,277 @@
+/*
+ * Filename: huffman_decoder.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef HUFFMAN_DECODER_H_
+#define HUFFMAN_DECODER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+#include "bit_reader.h"
+#include "code_points.h"
+#include "huffman_code.h"
+
+namespace huff
+{
+    // Quantidade de bits consultados de uma vez na tabela de decodificação
+    constexpr uint8_t DECODE_TABLE_BITS = 11;
+
+    // Quantidade de fluxos independentes de códigos de um bloco intercalado
+    constexpr uint8_t INTERLEAVED_STREAMS = 4;
+
+    // Um leitor para cada fluxo de um bloco intercalado
+    using InterleavedReaders = std::array<BitReader, INTERLEAVED_STREAMS>;
+
+    // Maior quantidade de símbolos em uma entrada da tabela de vários símbolos
+    constexpr uint8_t MULTI_DECODE_SYMBOLS = 4;
+
+    // Menor quantidade esperada de símbolos por consulta para que a tabela de vários
+    // símbolos seja usada
+    constexpr double MULTI_DECODE_MIN_AVERAGE = 1.75;
+
+    /**
+     * @brief Decodificador de Huffman baseado em tabela
+     *
+     * Os próximos DECODE_TABLE_BITS bits da entrada indexam uma tabela cujas entradas
+     * contêm o símbolo decodificado e o comprimento do seu código, de modo que cada
+     * símbolo custa uma consulta, em vez de um passo na trie por bit. Códigos mais
+     * longos que a tabela (símbolos raros) são resolvidos comparando os candidatos
+     * que compartilham o mesmo prefixo
+     *
+     * Quando os códigos são curtos, como em textos ASCII, DECODE_TABLE_BITS bits
+     * contêm mais de um código inteiro. Nesse caso, uma segunda tabela guarda, para
+     * cada valor desses bits, todos os símbolos (até MULTI_DECODE_SYMBOLS) cujos
+     * códigos cabem neles e a soma dos seus comprimentos, e a decodificação em um
+     * único fluxo de bytes obtém vários símbolos por consulta
+     **/
+    class HuffmanDecoder
+    {
+        private:
+            struct Entry
+            {
+                    // Símbolo decodificado ou, se length == 0, índice em m_longRanges
+                    uint16_t symbol = 0;
+                    uint8_t  length = 0;
+            };
+
+            struct MultiEntry
+            {
+                    unsigned char symbols[MULTI_DECODE_SYMBOLS] = {};
+                    uint8_t       count  = 0; // 0 se o primeiro código for longo
+                    uint8_t       length = 0; // Soma dos comprimentos dos códigos
+            };
+
+            struct LongRange
+            {
+                    uint32_t begin = 0;
+                    uint32_t end   = 0;
+            };
+
+            std::vector<Entry>      m_table;
+            std::vector<SymbolCode> m_longCodes;
+            std::vector<LongRange>  m_longRanges;
+
+            // Tabela de vários símbolos, vazia se não compensar
+            std::vector<MultiEntry> m_multiTable;
+
+            uint8_t m_tableBits;
+            uint8_t m_minLength;
+            uint8_t m_maxLength;
+
+            /**
+             * @brief Decodifica um símbolo cujo código é maior que a tabela
+             * @param reader Leitor posicionado no início do código
+             * @param entry Entrada da tabela correspondente ao prefixo
+             * @return O símbolo, ou -1 se nenhum código corresponder aos bits lidos
+             **/
+            int32_t DecodeLong(BitReader& reader, const Entry& entry) const;
+
+            /**
+             * @brief Constroi a tabela de vários símbolos a partir da tabela de um
+             *símbolo, se a quantidade esperada de símbolos por consulta for ao menos
+             *MULTI_DECODE_MIN_AVERAGE e todos os símbolos forem bytes
+             * @param codes Código de cada símbolo do alfabeto
+             **/
+            void BuildMulti(const std::vector<SymbolCode>& codes);
+
+            /**
+             * @brief Decodifica os símbolos de uma entrada da tabela de vários
+             *símbolos ou, se o primeiro código for longo, apenas um símbolo
+             *        O leitor deve ter sido recarregado com Refill()
+             * @param reader Leitor posicionado no início do código
+             * @param output Região com espaço para MULTI_DECODE_SYMBOLS bytes
+             * @return Quantidade de símbolos decodificados, ou 0 se nenhum código
+             *corresponder aos bits lidos
+             **/
+            inline uint8_t DecodeSymbols(BitReader&     reader,
+                                         unsigned char* output) const;
+
+            /**
+             * @brief Decode para uma stream com a tabela de vários símbolos
+             **/
+            bool DecodeMulti(BitReader&    reader,
+                             uint64_t      numBits,
+                             std::ostream& output,
+                             uint64_t&     numSymbols) const;
+
+            /**
+             * @brief Decode para uma região de memória com a tabela de vários
+             *símbolos
+             **/
+            bool DecodeMulti(BitReader&     reader,
+                             std::size_t    numSymbols,
+                             unsigned char* output) const;
+
+        public:
+            HuffmanDecoder();
+
+            /**
+             * @brief Constroi a tabela de decodificação e, se compensar, a de vários
+             *símbolos
+             * @param codes Código de cada símbolo do alfabeto
+             * @return Falso se algum código for maior que BIT_READER_MIN_BITS
+             **/
+            bool Build(const std::vector<SymbolCode>& codes);
+
+            /**
+             * @brief Decodifica o próximo símbolo
+             *        O leitor deve ter sido recarregado com Refill()
+             * @param reader Leitor posicionado no início do código
+             * @return O símbolo, ou -1 se nenhum código corresponder aos bits lidos
+             **/
+            inline int32_t DecodeSymbol(BitReader& reader) const;
+
+            /**
+             * @brief Diz se a tabela de vários símbolos é usada
+             **/
+            bool IsMultiSymbol() const;
+
+            /**
+             * @brief Decodifica `numBits` bits da entrada e grava os bytes na saída
+             * @param reader Leitor posicionado no início do payload
+             * @param numBits Quantidade de bits válidos do payload
+             * @param output Stream na qual os bytes decodificados serão escritos
+             * @param numSymbols Quantidade de símbolos decodificados
+             * @return Falso se a entrada contiver um código inválido
+             **/
+            bool Decode(BitReader&    reader,
+                        uint64_t      numBits,
+                        std::ostream& output,
+                        uint64_t&     numSymbols) const;
+
+            /**
+             * @brief Decodifica `numSymbols` símbolos e grava os bytes em memória
+             * @param reader Leitor posicionado no início do payload
+             * @param numSymbols Quantidade de símbolos que serão decodificados
+             * @param output Região com espaço para `numSymbols` bytes
+             * @return Falso se a entrada contiver um código inválido
+             **/
+            bool Decode(BitReader&     reader,
+                        std::size_t    numSymbols,
+                        unsigned char* output) const;
+
+            /**
+             * @brief Decodifica símbolos que representam sequências de bytes, como os
+             *do alfabeto de code points, até preencher `size` bytes
+             * @param reader Leitor posicionado no início do payload
+             * @param size Quantidade de bytes que serão decodificados
+             * @param output Região com espaço para `size` bytes
+             * @param sequences Bytes de cada símbolo, indexados pelo símbolo
+             * @param numSymbols Quantidade de símbolos decodificados
+             * @return Falso se a entrada contiver um código inválido ou se o último
+             *símbolo ultrapassar `size` bytes
+             **/
+            bool Decode(BitReader&                      reader,
+                        std::size_t                     size,
+                        unsigned char*                  output,
+                        const std::vector<SymbolBytes>& sequences,
+                        uint64_t&                       numSymbols) const;
+
+            /**
+             * @brief Decodifica símbolos até que a posição do leitor alcance ou passe
+             *`end` e acrescenta os bytes ao final de `output`
+             * @param reader Leitor posicionado no início de um código
+             * @param end Posição, contada pelo leitor, a partir da qual nenhum código
+             *é iniciado. O último código pode terminar depois dela
+             * @param output Bytes decodificados
+             * @return Falso se a entrada contiver um código inválido
+             **/
+            bool DecodeUntil(BitReader&                  reader,
+                             uint64_t                    end,
+                             std::vector<unsigned char>& output) const;
+
+            /**
+             * @brief Decodifica `numSymbols` símbolos distribuídos entre os fluxos de
+             *um bloco intercalado e grava os bytes em memória
+             *        O símbolo i está no fluxo i % INTERLEAVED_STREAMS. Um símbolo de
+             *cada fluxo é decodificado por vez: as consultas de fluxos diferentes não
+             *dependem umas das outras e são executadas em paralelo pelo processador
+             * @param readers Leitores posicionados no início de cada fluxo
+             * @param numSymbols Quantidade de símbolos que serão decodificados
+             * @param output Região com espaço para `numSymbols` bytes
+             * @return Falso se a entrada contiver um código inválido
+             **/
+            bool Decode(InterleavedReaders& readers,
+                        std::size_t         numSymbols,
+                        unsigned char*      output) const;
+
+            /**
+             * @brief Decodifica símbolos que representam sequências de bytes,
+             *distribuídos entre os fluxos de um bloco intercalado, até preencher
+             *`size` bytes
+             * @param readers Leitores posicionados no início de cada fluxo
+             * @param size Quantidade de bytes que serão decodificados
+             * @param output Região com espaço para `size` bytes
+             * @param sequences Bytes de cada símbolo, indexados pelo símbolo
+             * @param numSymbols Quantidade de símbolos decodificados
+             * @return Falso se a entrada contiver um código inválido ou se o último
+             *símbolo ultrapassar `size` bytes
+             **/
+            bool Decode(InterleavedReaders&             readers,
+                        std::size_t                     size,
+                        unsigned char*                  output,
+                        const std::vector<SymbolBytes>& sequences,
+                        uint64_t&                       numSymbols) const;
+    };
+
+    inline int32_t HuffmanDecoder::DecodeSymbol(BitReader& reader) const
+    {
+        const Entry& entry = this->m_table[reader.Peek(this->m_tableBits)];
+
+        if (entry.length == 0)
+            return this->DecodeLong(reader, entry);
+
+        reader.Consume(entry.length);
+        return entry.symbol;
+    }
+
+    inline uint8_t HuffmanDecoder::DecodeSymbols(BitReader&     reader,
+                                                 unsigned char* output) const
+    {
+        const MultiEntry& multi = this->m_multiTable[reader.Peek(DECODE_TABLE_BITS)];
+
+        if (multi.count > 0)
+        {
+            std::memcpy(output, multi.symbols, MULTI_DECODE_SYMBOLS);
+            reader.Consume(multi.length);
+            return multi.count;
+        }
+
+        int32_t symbol = this->DecodeSymbol(reader);
+
+        if (symbol < 0)
+            return 0;
+
+        *output = static_cast<unsigned char>(symbol);
+        return 1;
+    }
+} // namespace huff
+
+#endif // HUFFMAN_DECODER_H_
@@ -0,0 +1,92 @@
+/*
+ * Filename: huffman_tree.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef HUFFMAN_TREE_H_
+#define HUFFMAN_TREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace huff
+{
+    // Índice que representa a ausência de um nó
+    constexpr uint16_t TREE_NULL = UINT16_MAX;
+
+    // Nó da árvore de Huffman. Os filhos são índices na arena da árvore
+    struct TreeNode
+    {
+            uint64_t frequency;
+            uint16_t left;
+            uint16_t right;
+            uint16_t symbol; // Válido apenas nas folhas
+    };
+
+    /**
+     * @brief Árvore de Huffman armazenada em uma arena contígua
+     *
+     * Os nós são structs simples, referenciados por índices de 16 bits. A arena é
+     * alocada uma única vez, com espaço para a maior árvore possível, e reaproveitada
+     * a cada construção: criar um nó apenas ocupa a próxima posição, e descartar a
+     * árvore apenas zera a quantidade de nós
+     **/
+    class HuffmanTree
+    {
+        private:
+            std::vector<TreeNode> m_nodes;
+            std::size_t           m_maxNodes;
+            uint16_t              m_root;
+
+        public:
+            /**
+             * @brief Cria uma árvore vazia
+             * @param alphabetSize Quantidade de símbolos do alfabeto
+             **/
+            HuffmanTree(std::size_t alphabetSize);
+
+            /**
+             * @brief Descarta todos os nós, mantendo a arena
+             **/
+            void Clear();
+
+            /**
+             * @brief Cria uma folha
+             * @param symbol Símbolo da folha
+             * @param frequency Frequência do símbolo
+             * @return Índice da folha, ou TREE_NULL se a arena estiver cheia
+             **/
+            uint16_t AddLeaf(uint16_t symbol, uint64_t frequency);
+
+            /**
+             * @brief Cria um nó interno
+             * @param left Filho da esquerda (bit 0)
+             * @param right Filho da direita (bit 1)
+             * @param frequency Soma das frequências dos filhos
+             * @return Índice do nó, ou TREE_NULL se a arena estiver cheia
+             **/
+            uint16_t AddNode(uint16_t left, uint16_t right, uint64_t frequency);
+
+            /**
+             * @brief Diz se o nó é uma folha
+             **/
+            bool IsLeaf(uint16_t index) const;
+
+            const TreeNode& operator[](uint16_t index) const;
+
+            TreeNode& operator[](uint16_t index);
+
+            uint16_t GetRoot() const;
+
+            void SetRoot(uint16_t root);
+
+            /**
+             * @brief Quantidade de nós da árvore
+             **/
+            std::size_t Size() const;
+    };
+} // namespace huff
+
+#endif // HUFFMAN_TREE_H_
@@ -0,0 +1,123 @@
+/*
+ * Filename: input_file.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef INPUT_FILE_H_
+#define INPUT_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+namespace huff
+{
+    /**
+     * @brief Arquivo de entrada da compressão e da descompressão
+     *
+     * Arquivos regulares são mapeados em memória (mmap), com a dica de acesso
+     * sequencial (madvise), de modo que o conteúdo é lido diretamente do mapeamento,
+     * sem cópias para buffers intermediários. Os demais arquivos (pipes, dispositivos)
+     * são lidos por uma stream. Nos dois casos, o arquivo também pode ser lido como
+     * uma std::istream, usada na leitura dos cabeçalhos. O nome "-" representa a
+     * entrada padrão
+     **/
+    class InputFile
+    {
+        private:
+            // Buffer de stream sobre o mapeamento, sem cópias
+            class MappedBuffer : public std::streambuf
+            {
+                public:
+                    /**
+                     * @brief Associa o buffer a um bloco de memória
+                     * @param data Início do bloco
+                     * @param size Tamanho do bloco em bytes
+                     **/
+                    void Assign(const unsigned char* data, std::size_t size);
+
+                protected:
+                    pos_type seekoff(off_type                off,
+                                     std::ios_base::seekdir  dir,
+                                     std::ios_base::openmode which) override;
+
+                    pos_type seekpos(pos_type                pos,
+                                     std::ios_base::openmode which) override;
+            };
+
+            const unsigned char* m_data; // Início do mapeamento (nullptr sem mmap)
+            std::size_t          m_size;
+
+            MappedBuffer  m_buffer;
+            std::ifstream m_file;
+            std::istream  m_stream;
+
+        public:
+            /**
+             * @brief Abre o arquivo, mapeando-o em memória se for um arquivo regular
+             * @param filename Nome do arquivo
+             **/
+            InputFile(const std::string& filename);
+
+            ~InputFile();
+
+            InputFile(const InputFile&)            = delete;
+            InputFile& operator=(const InputFile&) = delete;
+
+            /**
+             * @brief Diz se o arquivo está mapeado em memória
+             **/
+            bool IsMapped() const;
+
+            /**
+             * @brief Início do mapeamento. Válido apenas se IsMapped()
+             **/
+            const unsigned char* GetData() const;
+
+            /**
+             * @brief Tamanho do mapeamento em bytes. Válido apenas se IsMapped()
+             **/
+            std::size_t GetSize() const;
+
+            /**
+             * @brief Stream de leitura do arquivo, que compartilha a posição de leitura
+             *com Read()
+             **/
+            std::istream& GetStream();
+
+            /**
+             * @brief Lê os próximos bytes do arquivo
+             *        Com o arquivo mapeado, `data` aponta diretamente para o mapeamento
+             *e o buffer não é usado. Caso contrário, os bytes são copiados para o
+             *buffer
+             * @param buffer Buffer com espaço para `size` bytes
+             * @param size Quantidade máxima de bytes lidos
+             * @param data Início dos bytes lidos
+             * @return Quantidade de bytes lidos, 0 no fim do arquivo
+             **/
+            std::size_t Read(unsigned char*        buffer,
+                             std::size_t           size,
+                             const unsigned char*& data);
+
+            /**
+             * @brief Informa que um trecho já lido não será mais usado. Com o arquivo
+             *mapeado, as páginas inteiramente contidas no trecho são liberadas, de modo
+             *que a memória ocupada pelo mapeamento não cresce com o tamanho do arquivo
+             * @param data Início do trecho, obtido com Read() ou GetData()
+             * @param size Tamanho do trecho em bytes
+             **/
+            void Release(const unsigned char* data, std::size_t size);
+
+            /**
+             * @brief Volta a posição de leitura para o início do arquivo
+             * @return Falso se o arquivo não permitir o retorno (pipes, por exemplo)
+             **/
+            bool Rewind();
+    };
+} // namespace huff
+
+#endif // INPUT_FILE_H_
@@ -0,0 +1,134 @@
+/*
+ * Filename: metrics.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "perf_counters.h"
+
+namespace huff
+{
+    // Fases medidas na compressão e na descompressão
+    enum class Phase : uint8_t
+    {
+        FREQUENCIES, // Cálculo das frequências
+        TRIE,        // Construção da trie
+        CODE,        // Construção dos códigos e da tabela de comprimentos
+        ENCODE,      // Escrita dos códigos
+        DECODE,      // Descompressão
+    };
+
+    // Medições de uma fase
+    struct PhaseMetrics
+    {
+            Phase         phase;
+            double        seconds = 0;
+            CounterValues counters; // Sem valores se os contadores estiverem inativos
+    };
+
+    /**
+     * @brief Medições de uma compressão ou descompressão
+     *
+     * Nas etapas paralelas do formato em blocos, o tempo de cada fase é a soma dos
+     * tempos de todas as threads, enquanto o tempo total é o tempo decorrido. As
+     * taxas (MB/s) são sempre calculadas sobre o tamanho do arquivo original
+     **/
+    struct Metrics
+    {
+            // Verdadeiro na compressão, falso na descompressão
+            bool compress = true;
+
+            // Medições de cada fase, na ordem da primeira medição
+            std::vector<PhaseMetrics> phases;
+            double                    totalSeconds = 0;
+
+            uint64_t inputBytes  = 0;
+            uint64_t outputBytes = 0;
+
+            // Quantidade de símbolos codificados ou decodificados
+            uint64_t numSymbols = 0;
+
+            // Bits dos códigos dos símbolos e bits de cabeçalhos e tabelas
+            uint64_t payloadBits = 0;
+            uint64_t headerBits  = 0;
+
+            // Bits acrescentados pelo limite de comprimento dos códigos
+            uint64_t limitBits     = 0;
+            uint8_t  maxCodeLength = 0;
+
+            /**
+             * @brief Soma o tempo e os contadores de uma fase
+             * @param phase Fase medida
+             * @param seconds Tempo em segundos
+             * @param counters Contadores de hardware da fase
+             **/
+            void AddPhase(Phase                phase,
+                          double               seconds,
+                          const CounterValues& counters = CounterValues());
+
+            /**
+             * @brief Diz se alguma fase tem valores de contadores de hardware
+             **/
+            bool HasCounters() const;
+
+            /**
+             * @brief Soma as fases e os contadores de outra medição, exceto o tempo
+             *total
+             * @param other Medição de outra thread
+             **/
+            void Merge(const Metrics& other);
+
+            /**
+             * @brief Tamanho do arquivo original em bytes
+             **/
+            uint64_t UncompressedBytes() const;
+
+            /**
+             * @brief Comprimento médio dos códigos, em bits por símbolo
+             **/
+            double AverageCodeLength() const;
+
+            /**
+             * @brief Taxa de processamento do arquivo original, em MB/s
+             * @param seconds Tempo de processamento
+             **/
+            double Throughput(double seconds) const;
+
+            /**
+             * @brief Quantidade de eventos por byte do arquivo original
+             * @param events Quantidade de eventos
+             **/
+            double PerByte(uint64_t events) const;
+
+            /**
+             * @brief Escreve os contadores de uma fase em uma linha, com o IPC e os
+             *branch misses por byte
+             * @param output Stream na qual ocorrerá a escrita
+             * @param counters Contadores da fase
+             **/
+            void PrintCounters(std::ostream&        output,
+                               const CounterValues& counters) const;
+
+            /**
+             * @brief Escreve as medições em texto, uma por linha
+             * @param output Stream na qual ocorrerá a escrita
+             **/
+            void PrintText(std::ostream& output) const;
+
+            /**
+             * @brief Escreve as medições como um objeto JSON em uma única linha
+             * @param output Stream na qual ocorrerá a escrita
+             **/
+            void PrintJson(std::ostream& output) const;
+    };
+} // namespace huff
+
+#endif // METRICS_H_
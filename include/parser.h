@@ -7,6 +7,7 @@
 #ifndef PARSER_H_
 #define PARSER_H_
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 
@@ -14,22 +15,19 @@
 
 namespace huff
 {
+    enum class Format : uint8_t;
+
     class Parser
     {
         public:
             /**
-             * @brief Diz se um arquivo está codificado como UTF-8
-             * @param file Nome do arquivo que será verificado
-             **/
-            static bool IsUTF8(std::ifstream& file);
-
-            /**
-             * @brief Diz se um arquivo contém a assinatura do programa
+             * @brief Diz se um arquivo contém uma das assinaturas do programa
              *        Somente arquivos que contém essa assinatura podem ser
              *descompactados
              * @param file Arquivo que será lido
+             * @param format Formato correspondente à assinatura encontrada
              **/
-            static bool CheckSignature(std::ifstream& file);
+            static bool CheckSignature(std::istream& file, Format& format);
 
             /**
              * @brief Determina se o arquivo binário é compátivel com este programa,
@@ -40,7 +38,8 @@ namespace huff
 
             /**
              * @brief Determina se o arquivo de texto é compátivel com este programa,
-             *isto é, pode ser compactado por ele
+             *isto é, pode ser compactado por ele. O arquivo não é aberto: a
+             *codificação UTF-8 é verificada durante o cálculo das frequências
              * @param file Nome do arquivo que será verificado
              **/
             static bool CheckEncodeCompatibility(std::string file);
@@ -0,0 +1,108 @@
+/*
+ * Filename: perf_counters.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace huff
+{
+    // Contadores de hardware medidos em cada fase
+    enum class Counter : uint8_t
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        CACHE_MISSES,
+        L1D_MISSES, // Leituras que não encontraram o dado na cache L1 de dados
+    };
+
+    constexpr uint8_t NUM_COUNTERS = 5;
+
+    // Valores dos contadores. Um contador só tem valor se o seu bit estiver marcado
+    // em `available`
+    struct CounterValues
+    {
+            std::array<uint64_t, NUM_COUNTERS> values    = {};
+            uint8_t                            available = 0;
+
+            bool Has(Counter counter) const
+            {
+                return this->available & (1 << static_cast<uint8_t>(counter));
+            }
+
+            uint64_t Get(Counter counter) const
+            {
+                return this->values[static_cast<uint8_t>(counter)];
+            }
+
+            CounterValues& operator+=(const CounterValues& other)
+            {
+                for (uint8_t i = 0; i < NUM_COUNTERS; i++)
+                    this->values[i] += other.values[i];
+
+                this->available |= other.available;
+                return *this;
+            }
+    };
+
+#ifdef HUFF_PERF_COUNTERS
+    /**
+     * @brief Contadores de hardware da thread atual, lidos com perf_event_open
+     *
+     * As threads criadas enquanto os contadores estão ativos também são contadas,
+     * desde que terminem antes de Stop(). Contadores que o processador ou o kernel
+     * não permitem abrir ficam sem valor
+     **/
+    class PerfCounters
+    {
+        private:
+            std::array<int, NUM_COUNTERS> m_fds;
+            bool                          m_opened;
+
+            /**
+             * @brief Abre os contadores na primeira chamada
+             **/
+            void Open();
+
+        public:
+            PerfCounters();
+
+            ~PerfCounters();
+
+            PerfCounters(const PerfCounters&)            = delete;
+            PerfCounters& operator=(const PerfCounters&) = delete;
+
+            /**
+             * @brief Zera e ativa os contadores
+             **/
+            void Start();
+
+            /**
+             * @brief Desativa os contadores
+             * @return Valores contados desde Start()
+             **/
+            CounterValues Stop();
+    };
+#else
+    // Sem HUFF_PERF_COUNTERS, os contadores não são compilados
+    class PerfCounters
+    {
+        public:
+            void Start() { }
+
+            CounterValues Stop()
+            {
+                return CounterValues();
+            }
+    };
+#endif
+} // namespace huff
+
+#endif // PERF_COUNTERS_H_
@@ -0,0 +1,107 @@
+/*
+ * Filename: utf8_validator.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#ifndef UTF8_VALIDATOR_H_
+#define UTF8_VALIDATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace huff
+{
+    // Posição que indica que nenhum byte inválido foi encontrado
+    constexpr uint64_t UTF8_VALID = UINT64_MAX;
+
+    // Maior quantidade de bytes de continuação em uma sequência UTF-8
+    constexpr uint8_t UTF8_MAX_CONTINUATION = 3;
+
+    /**
+     * @brief Procura a primeira sequência UTF-8 inválida em um bloco de memória
+     *
+     *        Rejeita bytes que nunca aparecem em UTF-8, sequências curtas ou longas
+     *demais, codificações não mínimas (overlong), surrogates e valores acima de
+     *U+10FFFF. Os blocos de 32 ou 16 bytes são verificados com AVX2 ou SSE4, conforme
+     *o processador, por meio de tabelas indexadas pelos nibbles de cada par de bytes;
+     *o restante e as sequências próximas de um erro são verificados byte a byte
+     * @param data Início do bloco, que deve começar no início de uma sequência
+     * @param size Tamanho do bloco em bytes
+     * @return Posição do início da primeira sequência inválida ou incompleta, ou
+     *UTF8_VALID
+     **/
+    uint64_t FindInvalidUTF8(const unsigned char* data, std::size_t size);
+
+    /**
+     * @brief Validação UTF-8 de uma entrada lida em partes
+     *
+     * Cada parte é validada de forma independente: os bytes de continuação no início
+     * da parte e a sequência incompleta no final ficam guardados, e são verificados
+     * quando a parte é unida à anterior e à seguinte. Assim, as partes podem ser
+     * validadas em qualquer ordem, inclusive por threads diferentes, desde que sejam
+     * unidas na ordem do arquivo com Append
+     **/
+    class UTF8Validator
+    {
+        private:
+            uint64_t m_size;  // Quantidade de bytes validados
+            uint64_t m_error; // Posição do primeiro byte inválido
+
+            // Bytes de continuação no início, que completam uma sequência anterior
+            unsigned char m_head[UTF8_MAX_CONTINUATION];
+            uint8_t       m_headSize;
+
+            // Sequência incompleta no final, completada pela parte seguinte
+            unsigned char m_tail[UTF8_MAX_CONTINUATION];
+            uint8_t       m_tailSize;
+
+            /**
+             * @brief Valida uma parte da entrada isoladamente
+             * @param data Início da parte
+             * @param size Tamanho da parte em bytes
+             **/
+            void Scan(const unsigned char* data, std::size_t size);
+
+            /**
+             * @brief Registra um erro, mantendo o primeiro
+             * @param offset Posição do byte inválido
+             **/
+            void SetError(uint64_t offset);
+
+        public:
+            UTF8Validator();
+
+            /**
+             * @brief Valida a próxima parte da entrada
+             * @param data Início da parte
+             * @param size Tamanho da parte em bytes
+             **/
+            void Update(const unsigned char* data, std::size_t size);
+
+            /**
+             * @brief Une a validação da parte seguinte à desta
+             * @param next Validação da parte que vem logo após as partes já validadas
+             **/
+            void Append(const UTF8Validator& next);
+
+            /**
+             * @brief Conclui a validação da entrada: bytes de continuação no início e
+             *uma sequência incompleta no final também são erros
+             * @return Verdadeiro se a entrada for UTF-8 válido
+             **/
+            bool Finish();
+
+            /**
+             * @brief Diz se nenhum erro foi encontrado até o momento
+             **/
+            bool IsValid() const;
+
+            /**
+             * @brief Posição do primeiro byte inválido, ou UTF8_VALID
+             **/
+            uint64_t GetErrorOffset() const;
+    };
+} // namespace huff
+
+#endif // UTF8_VALIDATOR_H_
@@ -0,0 +1,63 @@
+/*
+ * Filename: bit_reader.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "bit_reader.h"
+#include "huffman_compress.h"
+
+namespace huff
+{
+    BitReader::BitReader()
+        : BitReader(nullptr, 0)
+    { }
+
+    BitReader::BitReader(const unsigned char* data, std::size_t size)
+        : m_stream(nullptr),
+          m_data(data),
+          m_size(size),
+          m_pos(0),
+          m_accumulator(0),
+          m_numBits(0),
+          m_consumed(0)
+    { }
+
+    BitReader::BitReader(std::istream& stream)
+        : m_stream(&stream),
+          m_buffer(BUFFER_MAX_SIZE),
+          m_data(nullptr),
+          m_size(0),
+          m_pos(0),
+          m_accumulator(0),
+          m_numBits(0),
+          m_consumed(0)
+    { }
+
+    bool BitReader::Fetch()
+    {
+        if (not this->m_stream)
+            return false;
+
+        this->m_stream->read((char*)this->m_buffer.data(), this->m_buffer.size());
+
+        this->m_data = this->m_buffer.data();
+        this->m_size = this->m_stream->gcount();
+        this->m_pos  = 0;
+
+        return this->m_size > 0;
+    }
+
+    void BitReader::RefillSlow()
+    {
+        while (this->m_numBits < BIT_READER_MIN_BITS)
+        {
+            if (this->m_pos == this->m_size and not this->Fetch())
+                return;
+
+            this->m_accumulator |= uint64_t(this->m_data[this->m_pos++])
+                                   << (BIT_READER_MIN_BITS - this->m_numBits);
+            this->m_numBits += BYTE_SIZE;
+        }
+    }
+} // namespace huff
@@ -0,0 +1,105 @@
+/*
+ * Filename: bit_writer.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "bit_writer.h"
+#include "huffman_compress.h"
+
+#include <algorithm>
+
+namespace huff
+{
+    BitWriter::BitWriter()
+        : m_stream(nullptr),
+          m_buffer(BUFFER_MAX_SIZE),
+          m_size(0),
+          m_flushThreshold(SIZE_MAX),
+          m_accumulator(0),
+          m_numBits(0)
+    { }
+
+    BitWriter::BitWriter(std::ostream& stream)
+        : m_stream(&stream),
+          // Folga para a cópia de 8 bytes feita pelo Drain
+          m_buffer(BUFFER_MAX_SIZE + sizeof(m_accumulator)),
+          m_size(0),
+          m_flushThreshold(BUFFER_MAX_SIZE),
+          m_accumulator(0),
+          m_numBits(0)
+    { }
+
+    void BitWriter::WriteLong(uint64_t bits, uint8_t length)
+    {
+        this->Write(bits >> BIT_WRITER_MAX_CHUNK, length - BIT_WRITER_MAX_CHUNK);
+        this->Write(bits & ((uint64_t(1) << BIT_WRITER_MAX_CHUNK) - 1),
+                    BIT_WRITER_MAX_CHUNK);
+    }
+
+    uint8_t BitWriter::AlignToByte(bool fillWithOnes)
+    {
+        uint8_t padding = (BYTE_SIZE - this->m_numBits % BYTE_SIZE) % BYTE_SIZE;
+
+        if (padding > 0)
+            this->Write(fillWithOnes ? (uint64_t(1) << padding) - 1 : 0, padding);
+
+        this->Drain();
+        return padding;
+    }
+
+    void BitWriter::WriteBytes(const unsigned char* data, std::size_t size)
+    {
+        this->Drain();
+
+        while (size > 0)
+        {
+            if (this->m_size == this->m_buffer.size())
+                this->Commit();
+
+            std::size_t length =
+                std::min(size, this->m_buffer.size() - this->m_size);
+
+            std::memcpy(this->m_buffer.data() + this->m_size, data, length);
+            this->m_size += length;
+            data += length;
+            size -= length;
+        }
+
+        if (this->m_size >= this->m_flushThreshold)
+            this->Commit();
+    }
+
+    void BitWriter::Commit()
+    {
+        if (not this->m_stream)
+        {
+            this->m_buffer.resize(this->m_buffer.size() * 2);
+            return;
+        }
+
+        if (this->m_size > 0)
+        {
+            this->m_stream->write((char*)this->m_buffer.data(), this->m_size);
+            this->m_size = 0;
+        }
+    }
+
+    void BitWriter::Flush()
+    {
+        this->Drain();
+
+        if (this->m_stream)
+            this->Commit();
+    }
+
+    const unsigned char* BitWriter::GetData() const
+    {
+        return this->m_buffer.data();
+    }
+
+    std::size_t BitWriter::GetSize() const
+    {
+        return this->m_size;
+    }
+} // namespace huff
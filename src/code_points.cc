@@ -0,0 +1,112 @@
+/*
+ * Filename: code_points.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "code_points.h"
+
+#include <algorithm>
+
+namespace huff
+{
+    SymbolBytes ToBytes(uint32_t symbol)
+    {
+        SymbolBytes sb;
+
+        if (symbol < 0x80 or symbol >= CODE_POINT_LIMIT)
+        {
+            sb.bytes[0] = symbol < 0x80 ? symbol : symbol - CODE_POINT_LIMIT;
+            sb.length   = 1;
+            return sb;
+        }
+
+        sb.length = symbol < 0x800 ? 2 : symbol < 0x10000 ? 3 : 4;
+
+        // Os bytes de continuação guardam 6 bits cada, do último para o primeiro
+        for (uint8_t i = sb.length - 1; i > 0; i--)
+        {
+            sb.bytes[i] = 0x80 | (symbol & 0x3F);
+            symbol >>= 6;
+        }
+
+        // O byte inicial começa com tantos 1s quanto o tamanho da sequência
+        sb.bytes[0] = ((0xF00 >> sb.length) & 0xFF) | symbol;
+
+        return sb;
+    }
+
+    CodePointHistogram::CodePointHistogram()
+        : m_directory(CODE_POINT_ALPHABET_SIZE / CODE_POINT_PAGE_SIZE)
+    {
+        this->Clear();
+    }
+
+    void CodePointHistogram::Clear()
+    {
+        std::fill(this->m_directory.begin(),
+                  this->m_directory.end(),
+                  CODE_POINT_NO_PAGE);
+
+        // A página dos caracteres ASCII, comuns mesmo em textos de outros
+        // alfabetos, sempre existe e ocupa o início de m_entries
+        this->m_directory[0] = 0;
+        this->m_entries.assign(CODE_POINT_PAGE_SIZE, 0);
+    }
+
+    void CodePointHistogram::Count(const unsigned char* data, std::size_t size)
+    {
+        uint32_t    symbol;
+        std::size_t i = 0;
+
+        while (i < size)
+        {
+            if (data[i] < 0x80)
+            {
+                this->m_entries[data[i++]]++;
+                continue;
+            }
+
+            i += NextSymbol(data + i, size - i, symbol);
+
+            uint32_t& page = this->m_directory[symbol >> CODE_POINT_PAGE_BITS];
+
+            if (page == CODE_POINT_NO_PAGE)
+            {
+                page = this->m_entries.size();
+                this->m_entries.resize(page + CODE_POINT_PAGE_SIZE, 0);
+            }
+
+            this->m_entries[page + (symbol & (CODE_POINT_PAGE_SIZE - 1))]++;
+        }
+    }
+
+    void CodePointHistogram::List(std::vector<uint32_t>&    symbols,
+                                  std::vector<std::size_t>& frequencies)
+    {
+        symbols.clear();
+        frequencies.clear();
+
+        // O diretório é percorrido em ordem, então os símbolos ficam em ordem
+        // crescente, independentemente da ordem em que as páginas foram alocadas
+        for (uint32_t p = 0; p < this->m_directory.size(); p++)
+        {
+            uint32_t page = this->m_directory[p];
+
+            if (page == CODE_POINT_NO_PAGE)
+                continue;
+
+            for (uint32_t offset = 0; offset < CODE_POINT_PAGE_SIZE; offset++)
+            {
+                uint32_t& entry = this->m_entries[page + offset];
+
+                if (entry == 0)
+                    continue;
+
+                symbols.push_back((p << CODE_POINT_PAGE_BITS) | offset);
+                frequencies.push_back(entry);
+                entry = symbols.size() - 1;
+            }
+        }
+    }
+} // namespace huff
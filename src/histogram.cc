@@ -0,0 +1,52 @@
+/*
+ * Filename: histogram.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "histogram.h"
+#include "huffman_compress.h"
+
+namespace huff
+{
+    Histogram::Histogram()
+        : m_lanes(HISTOGRAM_LANES * ALPHABET_SIZE, 0)
+    { }
+
+    void Histogram::Count(const unsigned char* data, std::size_t size)
+    {
+        std::size_t* lane0 = this->m_lanes.data();
+        std::size_t* lane1 = lane0 + ALPHABET_SIZE;
+        std::size_t* lane2 = lane1 + ALPHABET_SIZE;
+        std::size_t* lane3 = lane2 + ALPHABET_SIZE;
+
+        std::size_t i = 0;
+        for (; i + HISTOGRAM_LANES <= size; i += HISTOGRAM_LANES)
+        {
+            lane0[data[i]]++;
+            lane1[data[i + 1]]++;
+            lane2[data[i + 2]]++;
+            lane3[data[i + 3]]++;
+        }
+
+        for (; i < size; i++)
+            lane0[data[i]]++;
+    }
+
+    void Histogram::Add(const Histogram& other)
+    {
+        for (std::size_t i = 0; i < this->m_lanes.size(); i++)
+            this->m_lanes[i] += other.m_lanes[i];
+    }
+
+    void Histogram::Merge(std::vector<std::size_t>& frequencies) const
+    {
+        frequencies.assign(ALPHABET_SIZE, 0);
+
+        for (uint8_t lane = 0; lane < HISTOGRAM_LANES; lane++)
+        {
+            for (std::size_t symbol = 0; symbol < ALPHABET_SIZE; symbol++)
+                frequencies[symbol] += this->m_lanes[lane * ALPHABET_SIZE + symbol];
+        }
+    }
+} // namespace huff
@@ -0,0 +1,437 @@
+/*
+ * Filename: huffman_code.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "huffman_code.h"
+#include "huffman_compress.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace huff
+{
+    void SortSymbols(const std::vector<std::size_t>& frequencies,
+                     std::vector<SymbolWeight>&      sorted)
+    {
+        sorted.clear();
+
+        for (std::size_t symbol = 0; symbol < frequencies.size(); symbol++)
+        {
+            if (frequencies[symbol] > 0)
+                sorted.push_back({ frequencies[symbol], uint16_t(symbol) });
+        }
+
+        // O vizinho nunca ocorre, então fica antes do símbolo
+        if (sorted.size() == 1)
+            sorted.insert(sorted.begin(), { 0, uint16_t(sorted.front().symbol ^ 1) });
+
+        std::sort(sorted.begin(),
+                  sorted.end(),
+                  [](const SymbolWeight& a, const SymbolWeight& b)
+                  {
+                      return a.weight < b.weight or
+                             (a.weight == b.weight and a.symbol < b.symbol);
+                  });
+    }
+
+    void ComputeCodeLengths(const std::vector<std::size_t>& frequencies,
+                            std::vector<SymbolWeight>&      sorted,
+                            std::vector<Code>&              codes)
+    {
+        codes.assign(frequencies.size(), Code());
+        SortSymbols(frequencies, sorted);
+
+        std::size_t n = sorted.size();
+
+        if (n == 0)
+            return;
+
+        // O campo `weight` guarda, em cada momento, a frequência de um nó, o índice
+        // do seu pai ou a sua profundidade. Os nós internos são criados da esquerda
+        // para a direita em ordem crescente de frequência, então as folhas ainda não
+        // usadas e os nós internos sem pai formam duas filas já ordenadas
+        auto A = [&sorted](std::size_t i) -> uint64_t& { return sorted[i].weight; };
+
+        // 1ª passada: cada posição `next` passa a ser um nó interno, e os nós
+        // combinados guardam o índice do pai
+        A(0) += A(1);
+
+        std::size_t root = 0; // Próximo nó interno sem pai
+        std::size_t leaf = 2; // Próxima folha não usada
+
+        for (std::size_t next = 1; next < n - 1; next++)
+        {
+            if (leaf >= n or A(root) < A(leaf))
+            {
+                A(next)   = A(root);
+                A(root++) = next;
+            }
+            else
+                A(next) = A(leaf++);
+
+            if (leaf >= n or (root < next and A(root) < A(leaf)))
+            {
+                A(next) += A(root);
+                A(root++) = next;
+            }
+            else
+                A(next) += A(leaf++);
+        }
+
+        // 2ª passada: profundidade de cada nó interno, a partir da raiz (n - 2)
+        A(n - 2) = 0;
+
+        for (std::size_t next = n - 2; next-- > 0;)
+            A(next) = A(A(next)) + 1;
+
+        // 3ª passada: profundidade das folhas. Em cada nível, os nós disponíveis que
+        // não são internos são folhas, atribuídas da direita para a esquerda
+        std::size_t available = 1;
+        std::size_t used      = 0;
+        uint64_t    depth     = 0;
+        std::size_t rootIndex = n - 1; // Nó interno atual mais 1
+        std::size_t next      = n;     // Folha atual mais 1
+
+        while (available > 0)
+        {
+            while (rootIndex > 0 and A(rootIndex - 1) == depth)
+            {
+                used++;
+                rootIndex--;
+            }
+
+            while (available > used)
+            {
+                A(--next) = depth;
+                available--;
+            }
+
+            available = 2 * used;
+            depth++;
+            used = 0;
+        }
+
+        for (const SymbolWeight& sw : sorted)
+            codes[sw.symbol].length = sw.weight;
+    }
+
+    bool AssignCanonicalCodes(std::vector<Code>& codes)
+    {
+        // Quantidade de códigos de cada comprimento
+        std::vector<uint64_t> lengthCount(BIT_READER_MIN_BITS + 1, 0);
+
+        for (const Code& code : codes)
+        {
+            if (code.length > BIT_READER_MIN_BITS)
+                return false;
+
+            lengthCount[code.length]++;
+        }
+
+        lengthCount[0] = 0;
+
+        // Primeiro código de cada comprimento
+        std::vector<uint64_t> nextCode(BIT_READER_MIN_BITS + 1, 0);
+        uint64_t              code = 0;
+
+        for (uint8_t length = 1; length <= BIT_READER_MIN_BITS; length++)
+        {
+            code = (code + lengthCount[length - 1]) << 1;
+            nextCode[length] = code;
+
+            // Mais códigos do que cabem no comprimento
+            if (lengthCount[length] > (uint64_t(1) << length) - code)
+                return false;
+        }
+
+        for (Code& c : codes)
+        {
+            if (c.length > 0)
+                c.bits = nextCode[c.length]++;
+        }
+
+        return true;
+    }
+
+    bool LimitCodeLengths(const std::vector<std::size_t>& frequencies,
+                          uint8_t                         maxLength,
+                          std::vector<Code>&              codes)
+    {
+        // Item do package-merge: uma folha (símbolo) ou um pacote formado por dois
+        // itens do nível mais profundo
+        struct Item
+        {
+                uint64_t weight;
+                int32_t  symbol; // -1 para pacotes
+                uint32_t left;
+                uint32_t right;
+        };
+
+        std::vector<Item>     items;
+        std::vector<uint32_t> leaves;
+
+        for (std::size_t symbol = 0; symbol < codes.size(); symbol++)
+        {
+            if (codes[symbol].length == 0)
+                continue;
+
+            leaves.push_back(items.size());
+            items.push_back(
+                Item { frequencies[symbol], static_cast<int32_t>(symbol), 0, 0 });
+        }
+
+        if (leaves.size() < 2 or
+            (maxLength < 64 and leaves.size() > (uint64_t(1) << maxLength)))
+            return false;
+
+        std::stable_sort(leaves.begin(),
+                         leaves.end(),
+                         [&items](uint32_t a, uint32_t b)
+                         { return items[a].weight < items[b].weight; });
+
+        // Começa no nível mais profundo, que contém apenas as folhas. A cada nível, os
+        // itens do nível anterior são agrupados em pares e intercalados com as folhas
+        std::vector<uint32_t> level = leaves;
+        std::vector<uint32_t> merged;
+
+        for (uint8_t depth = maxLength; depth > 1; depth--)
+        {
+            std::vector<uint32_t> packages;
+            for (std::size_t i = 0; i + 1 < level.size(); i += 2)
+            {
+                uint64_t weight = items[level[i]].weight + items[level[i + 1]].weight;
+
+                packages.push_back(items.size());
+                items.push_back(Item { weight, -1, level[i], level[i + 1] });
+            }
+
+            merged.clear();
+            std::merge(leaves.begin(),
+                       leaves.end(),
+                       packages.begin(),
+                       packages.end(),
+                       std::back_inserter(merged),
+                       [&items](uint32_t a, uint32_t b)
+                       { return items[a].weight < items[b].weight; });
+
+            level.swap(merged);
+        }
+
+        // Os 2n - 2 itens mais leves do último nível formam a solução. O comprimento
+        // do código de um símbolo é a quantidade de vezes que a sua folha aparece
+        // neles
+        for (uint32_t leaf : leaves)
+            codes[items[leaf].symbol].length = 0;
+
+        std::vector<uint32_t> stack(level.begin(),
+                                    level.begin() + 2 * leaves.size() - 2);
+
+        while (not stack.empty())
+        {
+            const Item& item = items[stack.back()];
+            stack.pop_back();
+
+            if (item.symbol >= 0)
+                codes[item.symbol].length++;
+            else
+            {
+                stack.push_back(item.left);
+                stack.push_back(item.right);
+            }
+        }
+
+        return true;
+    }
+
+    uint8_t MaxCodeLength(const std::vector<Code>& codes)
+    {
+        uint8_t maxLength = 0;
+        for (const Code& code : codes)
+            maxLength = std::max(maxLength, code.length);
+
+        return maxLength;
+    }
+
+    uint64_t EncodedBits(const std::vector<std::size_t>& frequencies,
+                         const std::vector<Code>&        codes)
+    {
+        uint64_t bits = 0;
+        for (std::size_t symbol = 0; symbol < frequencies.size(); symbol++)
+            bits += uint64_t(frequencies[symbol]) * codes[symbol].length;
+
+        return bits;
+    }
+
+    // Escreve a tabela de comprimentos. `symbolOf` converte a posição de um código
+    // em `codes` no símbolo correspondente
+    template <typename SymbolOf>
+    static void WriteTable(BitWriter&               writer,
+                           const std::vector<Code>& codes,
+                           uint8_t                  flags,
+                           uint8_t                  countBits,
+                           SymbolOf                 symbolOf)
+    {
+        std::size_t numSymbols = 0;
+        for (const Code& code : codes)
+            numSymbols += code.length > 0;
+
+        uint8_t width = std::bit_width(MaxCodeLength(codes));
+        writer.Write(flags | width, BYTE_SIZE);
+        writer.Write(numSymbols - 1, countBits);
+
+        std::size_t previous = 0; // Símbolo anterior mais 1
+
+        for (std::size_t i = 0; i < codes.size(); i++)
+        {
+            if (codes[i].length == 0)
+                continue;
+
+            // Código gama: (n - 1) zeros seguidos dos n bits da distância
+            std::size_t symbol = symbolOf(i);
+            uint64_t    gap    = symbol + 1 - previous;
+            writer.Write(0, std::bit_width(gap) - 1);
+            writer.Write(gap, std::bit_width(gap));
+
+            writer.Write(codes[i].length, width);
+            previous = symbol + 1;
+        }
+
+        writer.AlignToByte();
+    }
+
+    // Tamanho da tabela escrita por WriteTable com os mesmos parâmetros
+    template <typename SymbolOf>
+    static uint64_t
+    TableBits(const std::vector<Code>& codes, uint8_t countBits, SymbolOf symbolOf)
+    {
+        uint8_t     width    = std::bit_width(MaxCodeLength(codes));
+        uint64_t    bits     = BYTE_SIZE + countBits;
+        std::size_t previous = 0;
+
+        for (std::size_t i = 0; i < codes.size(); i++)
+        {
+            if (codes[i].length == 0)
+                continue;
+
+            std::size_t symbol = symbolOf(i);
+            bits += 2 * std::bit_width(symbol + 1 - previous) - 1 + width;
+            previous = symbol + 1;
+        }
+
+        return (bits + BYTE_SIZE - 1) / BYTE_SIZE * BYTE_SIZE;
+    }
+
+    void WriteCodeLengths(BitWriter& writer, const std::vector<Code>& codes)
+    {
+        WriteTable(writer, codes, 0, BYTE_SIZE, [](std::size_t i) { return i; });
+    }
+
+    void WriteCodeLengths(BitWriter&                   writer,
+                          const std::vector<Code>&     codes,
+                          const std::vector<uint32_t>& symbols)
+    {
+        WriteTable(writer,
+                   codes,
+                   CODE_POINT_TABLE_FLAG,
+                   CODE_POINT_COUNT_BITS,
+                   [&symbols](std::size_t i) { return symbols[i]; });
+    }
+
+    uint64_t CodeLengthsBits(const std::vector<Code>& codes)
+    {
+        return TableBits(codes, BYTE_SIZE, [](std::size_t i) { return i; });
+    }
+
+    uint64_t CodeLengthsBits(const std::vector<Code>&     codes,
+                             const std::vector<uint32_t>& symbols)
+    {
+        return TableBits(codes,
+                         CODE_POINT_COUNT_BITS,
+                         [&symbols](std::size_t i) { return symbols[i]; });
+    }
+
+    bool ReadCodeLengths(BitReader& reader, std::vector<Code>& codes)
+    {
+        std::vector<uint32_t> symbols;
+
+        return ReadCodeLengths(reader, codes, symbols) and symbols.empty();
+    }
+
+    bool ReadCodeLengths(BitReader&             reader,
+                         std::vector<Code>&     codes,
+                         std::vector<uint32_t>& symbols)
+    {
+        reader.Refill();
+        uint8_t flags      = reader.Peek(BYTE_SIZE);
+        bool    codePoints = flags & CODE_POINT_TABLE_FLAG;
+        uint8_t width      = flags & ~CODE_POINT_TABLE_FLAG;
+        uint8_t countBits  = codePoints ? CODE_POINT_COUNT_BITS : BYTE_SIZE;
+
+        std::size_t numSymbols =
+            (reader.Peek(BYTE_SIZE + countBits) & ((uint64_t(1) << countBits) - 1)) + 1;
+        reader.Consume(BYTE_SIZE + countBits);
+
+        if (width == 0 or width > std::bit_width(BIT_READER_MIN_BITS))
+            return false;
+
+        // No alfabeto de bytes, os códigos são indexados pelo próprio símbolo
+        std::size_t alphabetSize =
+            codePoints ? CODE_POINT_ALPHABET_SIZE : std::size_t(ALPHABET_SIZE);
+        uint8_t maxZeros = std::bit_width(alphabetSize) - 1;
+
+        codes.assign(codePoints ? numSymbols : ALPHABET_SIZE, Code());
+        symbols.clear();
+
+        std::size_t previous = 0; // Símbolo anterior mais 1
+
+        for (std::size_t i = 0; i < numSymbols; i++)
+        {
+            reader.Refill();
+
+            uint8_t zeros = 0;
+            while (reader.Peek(1) == 0 and zeros < maxZeros)
+            {
+                reader.Consume(1);
+                zeros++;
+            }
+
+            std::size_t symbol = previous + reader.Peek(zeros + 1) - 1;
+            reader.Consume(zeros + 1);
+
+            if (symbol >= alphabetSize)
+                return false;
+
+            Code& code = codes[codePoints ? i : symbol];
+            code.length = reader.Peek(width);
+            reader.Consume(width);
+
+            if (code.length == 0)
+                return false;
+
+            if (codePoints)
+                symbols.push_back(symbol);
+
+            previous = symbol + 1;
+        }
+
+        // Descarta os bits usados para completar o último byte
+        reader.Consume((BYTE_SIZE - reader.GetPosition() % BYTE_SIZE) % BYTE_SIZE);
+
+        return AssignCanonicalCodes(codes);
+    }
+
+    std::vector<SymbolCode> ListCodes(const std::vector<Code>& codes)
+    {
+        std::vector<SymbolCode> list;
+
+        for (std::size_t symbol = 0; symbol < codes.size(); symbol++)
+        {
+            if (codes[symbol].length > 0)
+                list.push_back(SymbolCode { static_cast<uint16_t>(symbol), codes[symbol] });
+        }
+
+        return list;
+    }
+} // namespace huff
@@ -6,181 +6,282 @@
 
 #include "huffman_compress.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+
 namespace huff
 {
-    Compress::Compress() { }
+    Compress::Compress()
+        : m_trie(ALPHABET_SIZE)
+    { }
+
+    Compress::Compress(const Options& options)
+        : m_options(options),
+          m_trie(ALPHABET_SIZE)
+    { }
 
     Compress::~Compress() { }
 
-    // TODO: Adicionar execeção para quando a leitura do byte no arquivo não puder ser
-    // feita ex.: 1110xx... No fim do arquivo -> Tentativa de ler mais bytes
-    void Compress::Frequencies(std::ifstream&                         string,
-                               rbtree::Map<std::string, std::size_t>& map)
+    const Metrics& Compress::GetMetrics() const
     {
-        unsigned char          byte;
-        std::string            byteSet;
-        std::bitset<BYTE_SIZE> bits;
+        return this->m_metrics;
+    }
 
-        // Buffer de leitura para otimizar o processo de leitura dos bits e contagem
-        // dos caracteres
-        unsigned char* bufferRead = new unsigned char[BUFFER_MAX_SIZE];
+    void Compress::StartPhase()
+    {
+        this->m_phaseStart = std::chrono::high_resolution_clock::now();
+
+        if (this->m_options.perfCounters)
+            this->m_counters.Start();
+    }
+
+    void Compress::EndPhase(Phase phase)
+    {
+        CounterValues counters;
+
+        if (this->m_options.perfCounters)
+            counters = this->m_counters.Stop();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        this->m_metrics.AddPhase(
+            phase,
+            std::chrono::duration<double>(end - this->m_phaseStart).count(),
+            counters);
+    }
+
+    void Compress::Frequencies(InputFile&                             input,
+                               std::vector<std::size_t>&              frequencies,
+                               UTF8Validator&                         validator,
+                               std::vector<std::vector<std::size_t>>& chunkFrequencies)
+    {
+        chunkFrequencies.clear();
 
-        while (string.read((char*)bufferRead, BUFFER_MAX_SIZE) or string.gcount() > 0)
+        // Sem o mapeamento, o arquivo não pode ser dividido e é lido em sequência
+        if (not input.IsMapped())
         {
-            for (std::size_t i = 0; i < string.gcount(); i++)
+            Histogram                  histogram;
+            std::vector<unsigned char> bufferRead(FREQUENCIES_READ_SIZE);
+            const unsigned char*       data;
+            std::size_t                size;
+
+            while ((size = input.Read(bufferRead.data(), bufferRead.size(), data)) > 0)
             {
+                histogram.Count(data, size);
 
-                byte = bufferRead[i];
-                bits = std::bitset<BYTE_SIZE>(byte);
-                byteSet.clear();
+                if (not this->m_options.binary)
+                    validator.Update(data, size);
+            }
 
-                if ((byte & ONE_BYTE_UTF8_MASK) == ONE_BYTE_UTF8_MASK)
-                { // 0xxxxxxx -> Deve ler 1 byte
-                    byteSet = bits.to_string();
-                }
-                else if ((byte & TWO_BYTE_UTF8_MASK) == TWO_BYTE_UTF8_MASK)
-                { // 110xxxxx -> Deve ler 2 bytes
-                    byteSet = bits.to_string();
+            histogram.Merge(frequencies);
+            return;
+        }
 
-                    i++;
-                    if (i >= string.gcount())
-                        string >> std::noskipws >> byte;
-                    else
-                        byte = bufferRead[i];
+        uint64_t fileSize  = input.GetSize();
+        uint64_t numChunks = (fileSize + FREQUENCIES_CHUNK_SIZE - 1) /
+                             FREQUENCIES_CHUNK_SIZE;
 
-                    bits = std::bitset<BYTE_SIZE>(byte);
-                    byteSet += bits.to_string();
-                }
-                else if ((byte & THREE_BYTE_UTF8_MASK) == THREE_BYTE_UTF8_MASK)
-                { // 1110xxxx -> Deve ler 3 bytes
-                    byteSet = bits.to_string();
+        std::size_t numThreads =
+            std::max<uint64_t>(1, std::min<uint64_t>(this->m_options.numThreads,
+                                                     numChunks));
 
-                    for (int j = 0; j < 2; j++)
-                    {
-                        i++;
-                        if (i >= string.gcount())
-                            string >> std::noskipws >> byte;
-                        else
-                            byte = bufferRead[i];
-
-                        bits = std::bitset<BYTE_SIZE>(byte);
-                        byteSet += bits.to_string();
-                    }
-                }
-                else if ((byte & FOUR_BYTE_UTF8_MASK) == FOUR_BYTE_UTF8_MASK)
-                { // 11110xxx -> Deve ler 4 bytes
-                    byteSet = bits.to_string();
+        std::vector<Histogram>     histograms(numThreads);
+        std::vector<UTF8Validator> validators(numChunks);
+        std::atomic<uint64_t>      nextChunk(0);
 
-                    for (int j = 0; j < 3; j++)
-                    {
-                        i++;
-                        if (i >= string.gcount())
-                            string >> std::noskipws >> byte;
-                        else
-                            byte = bufferRead[i];
-
-                        bits = std::bitset<BYTE_SIZE>(byte);
-                        byteSet += bits.to_string();
-                    }
-                }
+        chunkFrequencies.resize(numChunks);
+
+        // Cada thread pega a próxima parte ainda não contada até que não reste
+        // nenhuma. As partes são lidas diretamente do mapeamento e validadas de forma
+        // independente, em trechos de FREQUENCIES_READ_SIZE bytes. Cada parte é
+        // contada em um histograma próprio, somado depois ao da thread
+        auto worker = [&](Histogram& histogram)
+        {
+            for (uint64_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+            {
+                uint64_t  begin = chunk * FREQUENCIES_CHUNK_SIZE;
+                uint64_t  end   = std::min(begin + FREQUENCIES_CHUNK_SIZE, fileSize);
+                Histogram chunkHistogram;
 
-                if (not byteSet.empty())
+                for (uint64_t offset = begin; offset < end;
+                     offset += FREQUENCIES_READ_SIZE)
                 {
-                    // Incrementa o contador de frequência
-                    map[byteSet]++;
+                    uint64_t size =
+                        std::min<uint64_t>(FREQUENCIES_READ_SIZE, end - offset);
+
+                    // Cada byte é um símbolo
+                    chunkHistogram.Count(input.GetData() + offset, size);
+
+                    if (not this->m_options.binary)
+                        validators[chunk].Update(input.GetData() + offset, size);
                 }
+
+                histogram.Add(chunkHistogram);
+                chunkHistogram.Merge(chunkFrequencies[chunk]);
             }
-        }
+        };
 
-        delete[] bufferRead;
+        // A thread atual também conta partes do arquivo
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < numThreads; i++)
+            threads.emplace_back(worker, std::ref(histograms[i]));
+
+        worker(histograms[0]);
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (std::size_t i = 1; i < numThreads; i++)
+            histograms[0].Add(histograms[i]);
+
+        histograms[0].Merge(frequencies);
+
+        for (const UTF8Validator& chunk : validators)
+            validator.Append(chunk);
     }
 
-    void Compress::BuildTrie(rbtree::Map<std::string, std::size_t>& map)
+    void Compress::BuildTrie(const std::vector<std::size_t>& frequencies)
     {
-        bheap::PriorityQueue<dlkd::Node<TrieInfo>*> pqueue;
+        this->m_trie.Clear();
 
-        for (auto& pair : map)
-        {
-            pqueue.Enqueue(
-                new dlkd::Node<TrieInfo>(TrieInfo(pair.GetFirst(), pair.GetSecond())));
-        }
+        SortSymbols(frequencies, this->m_sorted);
 
-        dlkd::Node<TrieInfo>* x;
-        dlkd::Node<TrieInfo>* y;
+        if (this->m_sorted.empty())
+            return;
+
+        // As folhas ocupam as posições [0, n) da arena e os nós internos, as seguintes
+        for (const SymbolWeight& sw : this->m_sorted)
+            this->m_trie.AddLeaf(sw.symbol, sw.weight);
 
-        std::size_t freqSum = 0;
+        uint16_t numLeaves = this->m_sorted.size();
+        uint16_t leaf      = 0;         // Início da fila de folhas
+        uint16_t node      = numLeaves; // Início da fila de nós internos
 
-        while (pqueue.Size() > 1)
+        // Em caso de empate, a folha é escolhida primeiro
+        auto smallest = [&]()
         {
-            x = pqueue.Dequeue();
-            y = pqueue.Dequeue();
+            if (leaf < numLeaves and
+                (node == this->m_trie.Size() or
+                 this->m_trie[leaf].frequency <= this->m_trie[node].frequency))
+                return leaf++;
 
-            freqSum = x->GetValue().GetFrequencie() + y->GetValue().GetFrequencie();
+            return node++;
+        };
+
+        while (this->m_trie.Size() < 2 * std::size_t(numLeaves) - 1)
+        {
+            uint16_t x = smallest();
+            uint16_t y = smallest();
 
-            pqueue.Enqueue(new dlkd::Node<TrieInfo>(TrieInfo("", freqSum), x, y));
+            uint64_t freqSum = this->m_trie[x].frequency + this->m_trie[y].frequency;
+
+            this->m_trie.AddNode(x, y, freqSum);
         }
 
-        this->m_trie.InsertExistingTree(pqueue.Dequeue(), map.Size());
+        this->m_trie.SetRoot(this->m_trie.Size() - 1);
+    }
+
+    void Compress::BuildCodeLengths(const std::vector<std::size_t>& frequencies)
+    {
+        ComputeCodeLengths(frequencies, this->m_sorted, this->m_codeTable);
     }
 
     void Compress::BuildCode()
     {
-        this->BuildCode(this->m_trie.GetRoot(), "");
+        this->m_codeTable.assign(ALPHABET_SIZE, Code());
+        this->BuildCode(this->m_trie.GetRoot(), Code());
     }
 
-    void Compress::BuildCode(dlkd::Node<TrieInfo>* node, std::string code)
+    void Compress::BuildCode(uint16_t node, Code code)
     {
+        // Trie incompleta (cabeçalho corrompido)
+        if (node == TREE_NULL)
+            return;
 
         // Check if node is an leaf
-        if (not(node->GetLeftNode() or node->GetRightNode()))
+        if (this->m_trie.IsLeaf(node))
         {
-            this->m_map.Insert(node->GetValue().GetBits(), code);
+            this->m_codeTable[this->m_trie[node].symbol] = code;
             return;
         }
 
-        this->BuildCode(node->GetLeftNode(), code + "0");
-        this->BuildCode(node->GetRightNode(), code + "1");
+        code.length++;
+        code.bits <<= 1;
+        this->BuildCode(this->m_trie[node].left, code);
+
+        code.bits |= 1;
+        this->BuildCode(this->m_trie[node].right, code);
     }
 
-    void Compress::WriteBuffer(std::ofstream& file, std::string& buffer)
+    uint64_t Compress::LimitCode(const std::vector<std::size_t>& frequencies)
     {
-        if (not buffer.empty() and file.is_open())
-        {
-            std::size_t bufferSize = buffer.size();
-            std::size_t numBytes   = bufferSize / BYTE_SIZE;
+        if (MaxCodeLength(this->m_codeTable) <= this->m_options.maxCodeLength)
+            return 0;
+
+        uint64_t unlimitedBits = EncodedBits(frequencies, this->m_codeTable);
 
-            unsigned char* data = new unsigned char[numBytes];
+        if (not LimitCodeLengths(frequencies,
+                                 this->m_options.maxCodeLength,
+                                 this->m_codeTable))
+            throw huffexcpt::InvalidMaxCodeLength(this->m_options.maxCodeLength);
 
-            // Passa os bits na string para um array
-            for (std::size_t i = 0; i < numBytes; ++i)
+        AssignCanonicalCodes(this->m_codeTable);
+
+        if (this->m_options.format == Format::LEGACY)
+            this->BuildTrieFromCode();
+
+        return EncodedBits(frequencies, this->m_codeTable) - unlimitedBits;
+    }
+
+    void Compress::BuildTrieFromCode()
+    {
+        this->m_trie.Clear();
+        uint16_t root = this->m_trie.AddNode(TREE_NULL, TREE_NULL, 0);
+
+        for (const SymbolCode& sc : ListCodes(this->m_codeTable))
+        {
+            uint16_t node = root;
+
+            // Percorre o código a partir do bit mais significativo, criando os nós
+            // internos que ainda não existem
+            for (int i = sc.code.length - 1; i >= 0; i--)
             {
-                unsigned char byte = 0;
+                bool     right = (sc.code.bits >> i) & 1;
+                uint16_t next =
+                    right ? this->m_trie[node].right : this->m_trie[node].left;
 
-                for (std::size_t j = 0; j < BYTE_SIZE; ++j)
+                if (next == TREE_NULL)
                 {
-                    if (buffer[i * BYTE_SIZE + j] == '1')
-                        byte |= (1 << (BYTE_SIZE - 1 - j));
-                }
-                data[i] = byte;
-            }
-
-            // Escreve os dados do buffer no arquivo
-            file.write((char*)data, numBytes);
+                    next = i == 0 ? this->m_trie.AddLeaf(sc.symbol, 0)
+                                  : this->m_trie.AddNode(TREE_NULL, TREE_NULL, 0);
 
-            // Remove os dados que foram gravados do buffer
-            buffer = buffer.substr(numBytes * BYTE_SIZE);
+                    if (right)
+                        this->m_trie[node].right = next;
+                    else
+                        this->m_trie[node].left = next;
+                }
 
-            delete[] data;
+                node = next;
+            }
         }
+
+        this->m_trie.SetRoot(root);
     }
 
-    std::streampos Compress::WriteHeader(std::ofstream& file)
+    std::streampos Compress::WriteHeader(std::ofstream& file, BitWriter& writer)
     {
         // Volta a posição de escrita para o inicio do arquivo
         file.seekp(0, std::ios::beg);
 
         // Escreve a assinatura do programa nos primeiros bytes do arquivo
-        file.write(SIGNATURE.data(), SIGNATURE.size());
+        std::string_view signature = this->m_options.format == Format::CANONICAL
+                                         ? CANONICAL_SIGNATURE
+                                         : SIGNATURE;
+        file.write(signature.data(), signature.size());
         std::streampos signatureEndPos = file.tellp();
 
         // Reserva os bytes iniciais do arquivo do arquivo
@@ -190,17 +291,14 @@ namespace huff
 
         std::streampos headerStartPos = file.tellp();
 
-        std::string headerBuffer;
-        this->WriteTrie(file, this->m_trie.GetRoot(), headerBuffer);
+        if (this->m_options.format == Format::CANONICAL)
+            WriteCodeLengths(writer, this->m_codeTable);
+        else
+            this->WriteTrie(writer, this->m_trie.GetRoot());
 
-        if (headerBuffer.size() % BYTE_SIZE != 0)
-        { // Sobrou bits para serem gravados, completa com 0 é grava
-            while (headerBuffer.size() % BYTE_SIZE != 0)
-            {
-                headerBuffer += "0";
-            }
-            this->WriteBuffer(file, headerBuffer);
-        }
+        // Sobrou bits para serem gravados, completa com 0 e grava
+        writer.AlignToByte();
+        writer.Flush();
 
         // Calcula o tamanho do cabeçalho
         std::streampos headerEndPos = file.tellp();
@@ -216,212 +314,677 @@ namespace huff
         return headerEndPos;
     }
 
-    void Compress::WriteTrie(std::ofstream&        file,
-                             dlkd::Node<TrieInfo>* node,
-                             std::string&          buffer)
+    void Compress::WriteTrie(BitWriter& writer, uint16_t node)
     {
         // Check if node is an leaf
-        if (not(node->GetLeftNode() or node->GetRightNode()))
+        if (this->m_trie.IsLeaf(node))
         {
-            // bit 1 -> Nó folha
-            buffer += "1";
-            buffer += node->GetValue().GetBits();
-            this->WriteBuffer(file, buffer);
+            // bit 1 -> Nó folha, seguido do símbolo
+            writer.Write(1, 1);
+            writer.Write(this->m_trie[node].symbol, BYTE_SIZE);
         }
         else
         {
             // bit 0 -> Nó interno
-            buffer += "0";
-            WriteTrie(file, node->GetLeftNode(), buffer);
-            WriteTrie(file, node->GetRightNode(), buffer);
+            writer.Write(0, 1);
+            WriteTrie(writer, this->m_trie[node].left);
+            WriteTrie(writer, this->m_trie[node].right);
         }
     }
 
-    void Compress::Encode(std::string filename)
+    void Compress::EncodeSingleTable(std::string    filename,
+                                     InputFile&     input,
+                                     std::ofstream& output)
     {
-        Parser::CheckEncodeCompatibility(filename);
+        std::vector<std::size_t>              frequencies;
+        std::vector<std::vector<std::size_t>> chunkFrequencies;
+        UTF8Validator                         validator;
 
-        std::ifstream file(filename, std::ios::binary);
+        // Medição do tempo de execução do cálculo das frequências
+        this->StartPhase();
 
-        if (not file.is_open())
-            throw huffexcpt::CouldNotOpenFile(filename);
+        this->Frequencies(input, frequencies, validator, chunkFrequencies);
 
-        rbtree::Map<std::string, std::size_t> map;
+        this->EndPhase(Phase::FREQUENCIES);
 
-        // Inicio de medição do tempo total da compressão
-        auto encodeTime = std::chrono::high_resolution_clock::now();
+        if (not this->m_options.binary and not validator.Finish())
+            throw huffexcpt::IsNotUTF8Encoding(filename, validator.GetErrorOffset());
 
-        // Medição do tempo de execução do cálculo das frequências
-        auto start = std::chrono::high_resolution_clock::now();
+        // Medição do tempo de execução da construção da árvore. Apenas o formato
+        // legado grava a árvore; os demais precisam só dos comprimentos dos códigos
+        this->StartPhase();
 
-        this->Frequencies(file, map);
+        if (this->m_options.format == Format::LEGACY)
+            this->BuildTrie(frequencies);
+        else
+            this->BuildCodeLengths(frequencies);
 
-        auto end = std::chrono::high_resolution_clock::now();
-        std::cout << "Cálculo das Frequências: " << std::fixed
-                  << std::chrono::duration_cast<std::chrono::duration<double>>(end -
-                                                                               start)
-                  << std::endl;
+        this->EndPhase(Phase::TRIE);
 
-        // Medição do tempo de execução da construção da árvore
-        start = std::chrono::high_resolution_clock::now();
+        // Medição do tempo de execução da construção dos códigos
+        this->StartPhase();
 
-        this->BuildTrie(map);
+        if (this->m_options.format == Format::LEGACY)
+            this->BuildCode();
 
-        end = std::chrono::high_resolution_clock::now();
-        std::cout << "Construção da trie: " << std::fixed
-                  << std::chrono::duration_cast<std::chrono::duration<double>>(end -
-                                                                               start)
-                  << std::endl;
+        this->m_metrics.limitBits = this->LimitCode(frequencies);
 
-        // Medição do tempo de execução da construção dos códigos
-        start = std::chrono::high_resolution_clock::now();
+        // Os códigos canônicos dependem apenas dos comprimentos
+        if (this->m_options.format == Format::CANONICAL)
+            AssignCanonicalCodes(this->m_codeTable);
 
-        this->BuildCode();
+        this->EndPhase(Phase::CODE);
 
-        end = std::chrono::high_resolution_clock::now();
-        std::cout << "Construção dos códigos: " << std::fixed
-                  << std::chrono::duration_cast<std::chrono::duration<double>>(end -
-                                                                               start)
-                  << std::endl;
+        // O arquivo é lido novamente, do início
+        if (not input.Rewind())
+            throw huffexcpt::InputNotSeekable(filename);
 
-        file.clear();
-        file.seekg(0, std::ios::beg);
+        unsigned char* bufferRead = new unsigned char[BUFFER_MAX_SIZE];
 
-        unsigned char          byte;
-        std::string            byteSet;
-        std::bitset<BYTE_SIZE> bits;
-        std::string            bufferWrite;
+        // Medição do tempo de compressão do arquivo
+        this->StartPhase();
 
-        std::filesystem::path filePath(filename);
-        std::string           outputFile =
-            filePath.parent_path() /
-            (filePath.stem().string() + filePath.extension().string() + ".bin");
-        std::ofstream output(outputFile, std::ios::binary);
+        BitWriter writer(output);
 
-        if (not output.is_open())
-            throw huffexcpt::CouldNotOpenFile(outputFile);
+        // Escreve o cabeçalho do arquivo
+        std::streampos headerEnd = this->WriteHeader(output, writer);
+        output.seekp(headerEnd);
 
-        unsigned char* bufferRead = new unsigned char[BUFFER_MAX_SIZE];
+        unsigned char junkBitsOnLastbyte;
 
-        // Medição do tempo de compressão do arquivo
-        start = std::chrono::high_resolution_clock::now();
-        if (output.is_open())
+        // Com o arquivo mapeado e dividido em mais de uma parte, as partes são
+        // codificadas em paralelo
+        if (this->m_options.numThreads > 1 and chunkFrequencies.size() > 1)
+        {
+            junkBitsOnLastbyte = this->EncodeChunks(input.GetData(),
+                                                    input.GetSize(),
+                                                    chunkFrequencies,
+                                                    output);
+        }
+        else
         {
-            // Escreve o cabeçalho do arquivo
-            output.seekp(this->WriteHeader(output));
-
             // Inicia a escrita dos dados codificiados
-            while (file.read((char*)bufferRead, BUFFER_MAX_SIZE) or file.gcount() > 0)
+            const unsigned char* data;
+            std::size_t          size;
+
+            while ((size = input.Read(bufferRead, BUFFER_MAX_SIZE, data)) > 0)
             {
 
-                for (std::size_t i = 0; i < file.gcount(); i++)
+                for (std::size_t i = 0; i < size; i++)
                 {
-                    byte = bufferRead[i];
-                    bits = std::bitset<BYTE_SIZE>(byte);
-                    byteSet.clear();
+                    const Code& code = this->m_codeTable[data[i]];
+                    writer.Write(code.bits, code.length);
+                }
+            }
 
-                    if ((byte & ONE_BYTE_UTF8_MASK) == ONE_BYTE_UTF8_MASK)
-                    { // 0xxxxxxx -> Deve ler 1 byte
-                        byteSet = bits.to_string();
-                    }
-                    else if ((byte & TWO_BYTE_UTF8_MASK) == TWO_BYTE_UTF8_MASK)
-                    { // 110xxxxx -> Deve ler 2 bytes
-                        byteSet = bits.to_string();
-
-                        i++;
-                        if (i >= file.gcount())
-                            file >> std::noskipws >> byte;
-                        else
-                            byte = bufferRead[i];
-
-                        bits = std::bitset<BYTE_SIZE>(byte);
-                        byteSet += bits.to_string();
-                    }
-                    else if ((byte & THREE_BYTE_UTF8_MASK) == THREE_BYTE_UTF8_MASK)
-                    { // 1110xxxx -> Deve ler 3 bytes
-                        byteSet = bits.to_string();
-
-                        for (int j = 0; j < 2; j++)
-                        {
-                            i++;
-                            if (i >= file.gcount())
-                                file >> std::noskipws >> byte;
-                            else
-                                byte = bufferRead[i];
-
-                            bits = std::bitset<BYTE_SIZE>(byte);
-                            byteSet += bits.to_string();
-                        }
-                    }
-                    else if ((byte & FOUR_BYTE_UTF8_MASK) == FOUR_BYTE_UTF8_MASK)
-                    { // 11110xxx -> Deve ler 4 bytes
-                        byteSet = bits.to_string();
-
-                        for (int j = 0; j < 3; j++)
-                        {
-                            i++;
-                            if (i >= file.gcount())
-                                file >> std::noskipws >> byte;
-                            else
-                                byte = bufferRead[i];
-
-                            bits = std::bitset<BYTE_SIZE>(byte);
-                            byteSet += bits.to_string();
-                        }
-                    }
+            // Completa o último byte com 1s e o grava no arquivo
+            junkBitsOnLastbyte = writer.AlignToByte(true);
+            writer.Flush();
+        }
+
+        // Grava quantos bits são inválidos no último byte
+        output.seekp(SIGNATURE.size(), std::ios::beg);
+        output.write((char*)&junkBitsOnLastbyte, sizeof(junkBitsOnLastbyte));
+
+        delete[] bufferRead;
+
+        this->EndPhase(Phase::ENCODE);
+
+        for (std::size_t frequency : frequencies)
+            this->m_metrics.numSymbols += frequency;
+
+        uint64_t headerBytes = static_cast<uint64_t>(headerEnd);
+        uint64_t payloadBits = EncodedBits(frequencies, this->m_codeTable);
+
+        this->m_metrics.inputBytes  = this->m_metrics.numSymbols;
+        this->m_metrics.payloadBits = payloadBits;
+        this->m_metrics.headerBits  = headerBytes * BYTE_SIZE;
+        this->m_metrics.outputBytes =
+            headerBytes + (payloadBits + junkBitsOnLastbyte) / BYTE_SIZE;
+    }
+
+    uint8_t Compress::EncodeChunks(
+        const unsigned char*                         data,
+        uint64_t                                     size,
+        const std::vector<std::vector<std::size_t>>& chunkFrequencies,
+        std::ostream&                                output) const
+    {
+        uint64_t numChunks = chunkFrequencies.size();
+
+        // Posição, em bits, do início de cada parte no payload
+        std::vector<uint64_t> offsets(numChunks + 1, 0);
+        for (uint64_t c = 0; c < numChunks; c++)
+            offsets[c + 1] =
+                offsets[c] + EncodedBits(chunkFrequencies[c], this->m_codeTable);
+
+        // Codifica a parte em memória. Os bits do primeiro byte que pertencem à
+        // parte anterior ficam zerados, assim como os do último que pertencem à
+        // seguinte
+        auto encode = [&](uint64_t chunk, BitWriter& writer)
+        {
+            uint64_t begin = chunk * FREQUENCIES_CHUNK_SIZE;
+            uint64_t end   = std::min(begin + FREQUENCIES_CHUNK_SIZE, size);
+
+            writer.Write(0, offsets[chunk] % BYTE_SIZE);
+
+            for (uint64_t i = begin; i < end; i++)
+            {
+                const Code& code = this->m_codeTable[data[i]];
+                writer.Write(code.bits, code.length);
+            }
+
+            writer.AlignToByte();
+        };
+
+        std::vector<BitWriter> writers(
+            std::min<uint64_t>(this->m_options.numThreads, numChunks));
+        unsigned char          pending = 0; // Byte dividido com a parte seguinte
+
+        // Cada rodada codifica até numThreads partes, escritas na ordem do arquivo
+        for (uint64_t first = 0; first < numChunks; first += writers.size())
+        {
+            std::size_t count = std::min<uint64_t>(writers.size(), numChunks - first);
 
-                    bufferWrite += this->m_map[byteSet];
+            std::vector<std::thread> threads;
+
+            for (std::size_t c = 0; c < count; c++)
+            {
+                writers[c] = BitWriter();
+                threads.emplace_back(encode, first + c, std::ref(writers[c]));
+            }
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            for (std::size_t c = 0; c < count; c++)
+            {
+                const unsigned char* bytes = writers[c].GetData();
+                std::size_t          n     = writers[c].GetSize();
+
+                if (n == 0)
+                    continue;
+
+                // O primeiro byte completa o byte pendente da parte anterior, e o
+                // último fica pendente se a parte terminar no meio de um byte
+                unsigned char head     = bytes[0] | pending;
+                std::size_t   complete = n - (offsets[first + c + 1] % BYTE_SIZE != 0);
+
+                pending = complete == n ? 0 : complete == 0 ? head : bytes[n - 1];
+
+                if (complete == 0)
+                    continue;
+
+                output.put(head);
+                output.write((const char*)bytes + 1, complete - 1);
+            }
+        }
+
+        // Completa o último byte com 1s, como na codificação sequencial
+        uint8_t padding = (BYTE_SIZE - offsets[numChunks] % BYTE_SIZE) % BYTE_SIZE;
+
+        if (padding > 0)
+            output.put(pending | ((1 << padding) - 1));
+
+        return padding;
+    }
+
+    bool Compress::ChooseCodePoints(std::vector<std::size_t>& frequencies,
+                                    std::vector<std::size_t>& codePointFrequencies)
+    {
+        std::vector<Code> codePointCodes;
+
+        // Os códigos precisam caber no limite de comprimento e os símbolos, nos
+        // índices de 16 bits. Com um único símbolo, o alfabeto de bytes já é mínimo
+        std::size_t numSymbols = this->m_symbols.size();
+
+        if (numSymbols < 2 or numSymbols > CODE_POINT_MAX_SYMBOLS or
+            (this->m_options.maxCodeLength < 64 and
+             numSymbols > uint64_t(1) << this->m_options.maxCodeLength))
+            return false;
+
+        ComputeCodeLengths(codePointFrequencies, this->m_sorted, codePointCodes);
+
+        uint64_t byteBits = EncodedBits(frequencies, this->m_codeTable) +
+                            CodeLengthsBits(this->m_codeTable);
+        uint64_t codePointBits = EncodedBits(codePointFrequencies, codePointCodes) +
+                                 CodeLengthsBits(codePointCodes, this->m_symbols);
+
+        if (codePointBits >= byteBits)
+            return false;
+
+        this->m_codeTable.swap(codePointCodes);
+        frequencies.swap(codePointFrequencies);
+
+        return true;
+    }
+
+    template <uint8_t NUM_STREAMS>
+    void Compress::EncodeSymbols(const unsigned char* data,
+                                 std::size_t          size,
+                                 bool                 codePoints,
+                                 BitWriter*           writers)
+    {
+        if (codePoints)
+        {
+            // Os códigos dos caracteres ASCII, os primeiros símbolos em m_symbols,
+            // são consultados diretamente, sem o índice de dois níveis
+            Code ascii[0x80];
+
+            for (std::size_t i = 0;
+                 i < this->m_symbols.size() and this->m_symbols[i] < 0x80;
+                 i++)
+                ascii[this->m_symbols[i]] = this->m_codeTable[i];
+
+            uint32_t    symbol;
+            std::size_t k = 0; // Quantidade de símbolos escritos
+
+            for (std::size_t i = 0; i < size;)
+            {
+                const Code* code;
+
+                if (data[i] < 0x80)
+                    code = &ascii[data[i++]];
+                else
+                {
+                    i += NextSymbol(data + i, size - i, symbol);
+                    code = &this->m_codeTable[this->m_codePoints.Index(symbol)];
                 }
 
-                if (bufferWrite.size() >= BUFFER_MAX_SIZE)
-                    this->WriteBuffer(output, bufferWrite);
+                writers[k++ % NUM_STREAMS].Write(code->bits, code->length);
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < size; i++)
+            {
+                const Code& code = this->m_codeTable[data[i]];
+                writers[i % NUM_STREAMS].Write(code.bits, code.length);
             }
+        }
+    }
+
+    void Compress::EncodeBlock(const unsigned char* data,
+                               std::size_t          size,
+                               BitWriter&           writer,
+                               UTF8Validator&       validator)
+    {
+        Histogram                histogram;
+        std::vector<std::size_t> frequencies;
+
+        this->StartPhase();
+
+        histogram.Count(data, size);
+
+        if (not this->m_options.binary)
+            validator.Update(data, size);
+
+        histogram.Merge(frequencies);
+
+        // Apenas texto com caracteres fora do ASCII tem sequências de mais de um byte
+        // que podem ser agrupadas em um símbolo
+        bool text = not this->m_options.binary and
+                    std::any_of(frequencies.begin() + 0x80,
+                                frequencies.end(),
+                                [](std::size_t frequency) { return frequency > 0; });
+
+        std::vector<std::size_t> codePointFrequencies;
+
+        if (text)
+        {
+            this->m_codePoints.Clear();
+            this->m_codePoints.Count(data, size);
+            this->m_codePoints.List(this->m_symbols, codePointFrequencies);
+        }
+
+        this->EndPhase(Phase::FREQUENCIES);
+
+        this->StartPhase();
+
+        this->BuildCodeLengths(frequencies);
+
+        bool codePoints =
+            text and this->ChooseCodePoints(frequencies, codePointFrequencies);
+
+        this->EndPhase(Phase::TRIE);
+
+        this->StartPhase();
+
+        this->m_metrics.limitBits += this->LimitCode(frequencies);
+        AssignCanonicalCodes(this->m_codeTable);
 
-            if (not bufferWrite.empty())
+        if (codePoints)
+            WriteCodeLengths(writer, this->m_codeTable, this->m_symbols);
+        else
+            WriteCodeLengths(writer, this->m_codeTable);
+
+        this->EndPhase(Phase::CODE);
+
+        this->StartPhase();
+
+        uint8_t padding = 0;
+
+        if (this->m_options.format == Format::INTERLEAVED)
+        {
+            BitWriter streams[INTERLEAVED_STREAMS];
+            this->EncodeSymbols<INTERLEAVED_STREAMS>(data, size, codePoints, streams);
+
+            for (BitWriter& stream : streams)
+                padding += stream.AlignToByte(true);
+
+            // O tamanho do último fluxo é deduzido do tamanho do bloco
+            for (uint8_t s = 0; s + 1 < INTERLEAVED_STREAMS; s++)
+                writer.Write(streams[s].GetSize(),
+                             BYTE_SIZE * BLOCK_FIELD_SIZE_IN_BYTES);
+
+            for (BitWriter& stream : streams)
+                writer.WriteBytes(stream.GetData(), stream.GetSize());
+        }
+        else
+        {
+            this->EncodeSymbols<1>(data, size, codePoints, &writer);
+            padding = writer.AlignToByte(true);
+        }
+
+        writer.Flush();
+
+        this->EndPhase(Phase::ENCODE);
+
+        // A tabela (e os tamanhos dos fluxos) é o que resta do bloco além dos códigos
+        // e do preenchimento
+        uint64_t payloadBits = EncodedBits(frequencies, this->m_codeTable);
+
+        this->m_metrics.inputBytes += size;
+
+        for (std::size_t frequency : frequencies)
+            this->m_metrics.numSymbols += frequency;
+
+        this->m_metrics.payloadBits += payloadBits;
+        this->m_metrics.headerBits +=
+            uint64_t(writer.GetSize()) * BYTE_SIZE - payloadBits - padding;
+    }
+
+    void Compress::EncodeBlocks(std::string   filename,
+                                InputFile&    input,
+                                std::ostream& output)
+    {
+        std::string_view signature = this->m_options.format == Format::INTERLEAVED
+                                         ? INTERLEAVED_SIGNATURE
+                                         : BLOCK_SIGNATURE;
+
+        output.write(signature.data(), signature.size());
+        WriteBlockField(output, this->m_options.blockSize);
+
+        // Bloco comprimido aguardando a sua vez de ser escrito
+        struct EncodedBlock
+        {
+                BitWriter     body;
+                UTF8Validator validator;
+                uint32_t      rawSize = 0;
+                bool          ready   = false;
+        };
+
+        // Cada thread lê o próximo bloco e o comprime com o seu próprio estado. A
+        // thread atual escreve os blocos na ordem do arquivo original à medida que
+        // ficam prontos. No máximo `window` blocos ficam em memória ao mesmo tempo
+        // Com o arquivo mapeado, a quantidade de blocos é conhecida, e não há
+        // mais threads do que blocos
+        std::size_t numThreads = this->m_options.numThreads;
+        if (input.IsMapped())
+        {
+            uint64_t numBlocks = (input.GetSize() + this->m_options.blockSize - 1) /
+                                 this->m_options.blockSize;
+
+            numThreads =
+                std::max<uint64_t>(1, std::min<uint64_t>(numThreads, numBlocks));
+        }
+
+        std::size_t               window = 2 * numThreads;
+        std::vector<EncodedBlock> blocks(window);
+
+        std::mutex              mutex;
+        std::condition_variable condition;
+        uint64_t                nextRead  = 0;
+        uint64_t                nextWrite = 0;
+        bool                    endOfFile = false;
+        std::exception_ptr      error;
+
+        // Medições de cada thread, somadas ao final
+        std::vector<Metrics> workerMetrics(numThreads);
+
+        auto worker = [&](Metrics& metrics)
+        {
+            Compress encoder(this->m_options);
+
+            // Com o arquivo mapeado, os blocos são lidos diretamente do mapeamento
+            std::size_t                bufferSize = this->m_options.blockSize;
+            std::vector<unsigned char> block(input.IsMapped() ? 0 : bufferSize);
+
+            while (true)
             {
-                // Completa o último byte e o grava no arquivo
-                std::size_t junkBitsOnLastbyte = 0;
-                if (bufferWrite.size() % BYTE_SIZE != 0)
+                uint64_t             sequence;
+                const unsigned char* data;
+                std::size_t          size;
+
                 {
-                    while (bufferWrite.size() % BYTE_SIZE != 0)
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock,
+                                   [&]()
+                                   {
+                                       return endOfFile or error or
+                                              nextRead < nextWrite + window;
+                                   });
+
+                    if (endOfFile or error)
+                        break;
+
+                    size = input.Read(block.data(), this->m_options.blockSize, data);
+
+                    if (size == 0)
                     {
-                        bufferWrite += "1";
-                        junkBitsOnLastbyte++;
+                        endOfFile = true;
+                        condition.notify_all();
+                        break;
                     }
+
+                    sequence = nextRead++;
+                }
+
+                BitWriter     body;
+                UTF8Validator validator;
+
+                try
+                {
+                    encoder.EncodeBlock(data, size, body, validator);
+                    input.Release(data, size);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = std::current_exception();
+                    condition.notify_all();
+                    break;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    EncodedBlock& encoded = blocks[sequence % window];
+                    encoded.body          = std::move(body);
+                    encoded.validator     = validator;
+                    encoded.rawSize       = size;
+                    encoded.ready         = true;
                 }
-                this->WriteBuffer(output, bufferWrite);
 
-                // Grava quantos bits são inválidos no último byte
-                output.seekp(SIGNATURE.size(), std::ios::beg);
-                unsigned char byte = junkBitsOnLastbyte;
-                output.write((char*)&byte, sizeof(byte));
+                condition.notify_all();
+            }
+
+            metrics = encoder.m_metrics;
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < numThreads; i++)
+            threads.emplace_back(worker, std::ref(workerMetrics[i]));
+
+        uint64_t      outputBytes = 0;
+        UTF8Validator validator;
+
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            EncodedBlock&                encoded = blocks[nextWrite % window];
+
+            condition.wait(lock,
+                           [&]()
+                           {
+                               return error or encoded.ready or
+                                      (endOfFile and nextWrite == nextRead);
+                           });
+
+            if (error or not encoded.ready)
+                break;
+
+            // O bloco só é escrito se o arquivo for UTF-8 válido até o seu fim
+            validator.Append(encoded.validator);
+
+            if (not validator.IsValid())
+            {
+                error = std::make_exception_ptr(
+                    huffexcpt::IsNotUTF8Encoding(filename, validator.GetErrorOffset()));
+                condition.notify_all();
+                break;
             }
 
-            output.close();
-            file.close();
+            // Nenhuma outra thread usa o bloco até que ele seja liberado
+            lock.unlock();
 
-            delete[] bufferRead;
+            WriteBlockField(output, encoded.rawSize);
+            WriteBlockField(output, encoded.body.GetSize());
+            output.write((char*)encoded.body.GetData(), encoded.body.GetSize());
+            outputBytes += encoded.body.GetSize();
 
-            end = std::chrono::high_resolution_clock::now();
-            std::cout << "Compressão do arquivo: " << std::fixed
-                      << std::chrono::duration_cast<std::chrono::duration<double>>(
-                             end - start)
-                      << std::endl;
-            std::cout << "Tempo total: " << std::fixed
-                      << std::chrono::duration_cast<std::chrono::duration<double>>(
-                             end - encodeTime)
-                      << std::endl;
+            lock.lock();
+            encoded.body  = BitWriter();
+            encoded.ready = false;
+            nextWrite++;
+            condition.notify_all();
         }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+
+        if (not validator.Finish())
+            throw huffexcpt::IsNotUTF8Encoding(filename, validator.GetErrorOffset());
+
+        // Marcador de fim: bloco sem bytes
+        WriteBlockField(output, 0);
+        WriteBlockField(output, 0);
+
+        for (const Metrics& metrics : workerMetrics)
+            this->m_metrics.Merge(metrics);
+
+        // Assinatura, tamanho dos blocos e campos de tamanho de cada bloco e do
+        // marcador de fim
+        uint64_t fieldBytes = BLOCK_SIGNATURE.size() + BLOCK_FIELD_SIZE_IN_BYTES +
+                              2 * BLOCK_FIELD_SIZE_IN_BYTES * (nextWrite + 1);
+
+        this->m_metrics.outputBytes = outputBytes + fieldBytes;
+        this->m_metrics.headerBits += fieldBytes * BYTE_SIZE;
+    }
+
+    void Compress::WriteBlockField(std::ostream& output, uint32_t value)
+    {
+        for (int i = BLOCK_FIELD_SIZE_IN_BYTES - 1; i >= 0; i--)
+            output.put((value >> (BYTE_SIZE * i)) & BYTE_MASK);
     }
 
-    std::size_t Compress::ReadHeader(std::ifstream& file, std::string filename)
+    bool Compress::ReadBlockField(std::istream& input, uint32_t& value)
     {
-        // Volta a posição de leitura para o inicio do arquivo
-        file.seekg(0, std::ios::beg);
+        unsigned char bytes[BLOCK_FIELD_SIZE_IN_BYTES];
+
+        if (not input.read((char*)bytes, sizeof(bytes)))
+            return false;
+
+        value = 0;
+        for (unsigned char byte : bytes)
+            value = (value << BYTE_SIZE) | byte;
+
+        return true;
+    }
+
+    void Compress::Encode(std::string filename)
+    {
+        // Com a entrada padrão, o binário é escrito na saída padrão, que não permite
+        // voltar a posição de escrita. Apenas os formatos em blocos são escritos em
+        // sequência, sem voltar para completar o cabeçalho
+        bool streaming = filename == STREAM_NAME;
+        bool blocks    = this->m_options.format == Format::BLOCK or
+                      this->m_options.format == Format::INTERLEAVED;
+
+        if (streaming and not blocks)
+            throw huffexcpt::InputNotSeekable(filename);
+
+        if (not streaming)
+            Parser::CheckEncodeCompatibility(filename);
+
+        InputFile input(filename);
+
+        std::filesystem::path filePath(filename);
+        std::string           outputFile =
+            filePath.parent_path() /
+            (filePath.stem().string() + filePath.extension().string() + ".bin");
+        std::ofstream file;
+        std::ostream  output(std::cout.rdbuf());
+
+        if (not streaming)
+        {
+            file.open(outputFile, std::ios::binary);
+
+            if (not file.is_open())
+                throw huffexcpt::CouldNotOpenFile(outputFile);
+
+            output.rdbuf(file.rdbuf());
+        }
+
+        this->m_metrics               = Metrics();
+        this->m_metrics.maxCodeLength = this->m_options.maxCodeLength;
 
-        if (not Parser::CheckSignature(file))
-            throw huffexcpt::InvalidSignature(filename);
+        // Inicio de medição do tempo total da compressão
+        auto encodeTime = std::chrono::high_resolution_clock::now();
+
+        try
+        {
+            if (blocks)
+                this->EncodeBlocks(filename, input, output);
+            else
+                this->EncodeSingleTable(filename, input, file);
+        }
+        catch (...)
+        {
+            // Não deixa um binário incompleto para trás (por exemplo, quando um byte
+            // inválido é encontrado no meio do arquivo)
+            if (not streaming)
+            {
+                file.close();
+                std::filesystem::remove(outputFile);
+            }
+
+            throw;
+        }
+
+        output.flush();
+        file.close();
 
+        auto end = std::chrono::high_resolution_clock::now();
+        this->m_metrics.totalSeconds =
+            std::chrono::duration<double>(end - encodeTime).count();
+    }
+
+    std::size_t Compress::ReadHeader(std::istream& file,
+                                     Format        format,
+                                     std::string   filename)
+    {
         // Lê quantos bits do último byte são inválidos
         unsigned char junkBitsOnLastByte;
         file.read((char*)&junkBitsOnLastByte, sizeof(junkBitsOnLastByte));
@@ -440,213 +1003,724 @@ namespace huff
 
         headerSize |= headerSizeBytes[HEADER_SIZE_IN_BYTES - 1];
 
-        // Grava os dados do cabeçalho em um vector
-        // Vector com tamanho do cabaçalho em bits
-        Vector<bool> headerData(headerSize);
+        std::size_t headerBytes =
+            SIGNATURE.size() + HEADER_RESERVED_BYTES_AT_START + headerSize;
+        this->m_metrics.headerBits = headerBytes * BYTE_SIZE;
 
-        for (std::size_t i = 0; i < headerSize; ++i)
+        std::vector<unsigned char> headerData(headerSize);
+        file.read((char*)headerData.data(), headerSize);
+
+        BitReader reader(headerData.data(), file.gcount());
+
+        if (format == Format::CANONICAL)
         {
-            unsigned char byte;
-            file.read((char*)&byte, sizeof(byte));
+            // Os códigos são reconstruídos diretamente da tabela de comprimentos
+            if (file.gcount() != static_cast<std::streamsize>(headerSize) or
+                not ReadCodeLengths(reader, this->m_codeTable))
+                throw huffexcpt::CorruptedFile(filename);
 
-            // Armazena cada bit em uma posição do vector
-            for (int j = BYTE_SIZE - 1; j >= 0; j--)
-            {
-                bool bit = (byte >> j) & 1;
-                headerData.PushBack(bit);
-            }
+            return junkBitsOnLastByte;
         }
 
-        // Reconstroí a Huffman trie
-        std::size_t           numNodes = 0; // Número de nós na árvore
-        std::size_t           pos      = 0; // Posição no vector
-        dlkd::Node<TrieInfo>* root     = new dlkd::Node<TrieInfo>(TrieInfo("root", 0));
-        root->SetLeftNode(this->RebuildTrie(file, headerData, pos, numNodes));
-        root->SetRightNode(this->RebuildTrie(file, headerData, pos, numNodes));
+        // Reconstroí a Huffman trie. O primeiro bit é o da raiz, que é sempre um nó
+        // interno
+        uint64_t headerBits = static_cast<uint64_t>(file.gcount()) * BYTE_SIZE;
 
-        // Armazena a árvore reconstruída
-        this->m_trie.DeleteTree();
-        this->m_trie.InsertExistingTree(root, numNodes);
+        reader.Refill();
+        reader.Consume(1);
+
+        this->m_trie.Clear();
+        uint16_t left  = this->RebuildTrie(reader, headerBits, 1);
+        uint16_t right = this->RebuildTrie(reader, headerBits, 1);
+        this->m_trie.SetRoot(this->m_trie.AddNode(left, right, 0));
+
+        this->BuildCode();
 
         // Retorna quantos bits do último byte são inválidos
         return junkBitsOnLastByte;
     }
 
-    void Compress::Decode(std::string binFile)
+    void Compress::DecodeSingleTable(InputFile&    input,
+                                     Format        format,
+                                     std::ostream& output,
+                                     std::string   filename)
     {
-        Parser::CheckDecodeCompatibility(binFile);
+        std::istream& bin                = input.GetStream();
+        std::size_t   junkBitsOnLastByte = this->ReadHeader(bin, format, filename);
+
+        // Cabeçalho maior que o arquivo
+        if (not bin)
+            throw huffexcpt::CorruptedFile(filename);
+
+        // O payload vai do fim do cabeçalho até o fim do arquivo. Com o arquivo
+        // mapeado, ele é lido diretamente do mapeamento. Caso contrário (pipes), o
+        // seu tamanho só é conhecido no fim da stream, então ele é lido para a
+        // memória
+        std::vector<unsigned char> payloadData;
+        const unsigned char*       payload;
+        uint64_t                   payloadBytes;
+
+        if (input.IsMapped())
+        {
+            uint64_t headerEnd = bin.tellg();
 
-        std::ifstream bin(binFile, std::ios::binary);
+            payload      = input.GetData() + headerEnd;
+            payloadBytes = input.GetSize() - headerEnd;
+        }
+        else
+        {
+            payloadData.assign(std::istreambuf_iterator<char>(bin),
+                               std::istreambuf_iterator<char>());
 
-        std::filesystem::path filePath(binFile);
+            payload      = payloadData.data();
+            payloadBytes = payloadData.size();
+        }
 
-        std::string extension = filePath.extension().string();
-        if (extension.length() >= 4 &&
-            extension.substr(extension.length() - 4) == ".bin")
-            filePath.replace_extension("");
+        uint64_t payloadBits = payloadBytes * BYTE_SIZE;
 
-        std::string originalFileName =
-            filePath.parent_path() / filePath.stem().string();
-        std::string originalExtension = filePath.extension().string();
+        if (payloadBits < junkBitsOnLastByte)
+            throw huffexcpt::CorruptedFile(filename);
 
-        std::string outputFileName =
-            filePath.parent_path() /
-            (filePath.stem().string() + "-decompressed" + originalExtension);
-        std::ofstream decompress(outputFileName, std::ios::binary);
+        payloadBits -= junkBitsOnLastByte;
+
+        HuffmanDecoder decoder;
+        BitReader      reader(payload, payloadBytes);
 
-        // Obtém a posição atual
-        std::streampos binSize = bin.tellg();
+        if (not decoder.Build(ListCodes(this->m_codeTable)))
+            throw huffexcpt::CorruptedFile(filename);
 
-        if (not decompress.is_open())
-            throw huffexcpt::CouldNotOpenFile(outputFileName);
+        uint64_t& numSymbols = this->m_metrics.numSymbols;
+        bool      decoded;
 
-        std::size_t junkBitsOnLastByte = this->ReadHeader(bin, binFile);
+        // Com uma única parte, não há o que decodificar em paralelo
+        if (this->m_options.numThreads > 1 and payloadBytes > SPECULATIVE_CHUNK_SIZE)
+            decoded = this->DecodeSpeculative(
+                decoder, payload, payloadBytes, payloadBits, output, numSymbols);
+        else
+            decoded = decoder.Decode(reader, payloadBits, output, numSymbols);
+
+        if (not decoded)
+            throw huffexcpt::CorruptedFile(filename);
+
+        this->m_metrics.inputBytes =
+            this->m_metrics.headerBits / BYTE_SIZE + payloadBytes;
+        this->m_metrics.outputBytes = this->m_metrics.numSymbols;
+        this->m_metrics.payloadBits = payloadBits;
+    }
 
-        dlkd::Node<TrieInfo>* current = this->m_trie.GetRoot();
+    bool Compress::DecodeSpeculative(const HuffmanDecoder& decoder,
+                                     const unsigned char*  payload,
+                                     uint64_t              payloadBytes,
+                                     uint64_t              payloadBits,
+                                     std::ostream&         output,
+                                     uint64_t&             numSymbols) const
+    {
+        // Parte do payload decodificada por uma thread
+        struct Chunk
+        {
+                uint64_t                   begin = 0;
+                uint64_t                   end   = 0;
+                uint64_t                   base  = 0; // Posição do início do leitor
+                BitReader                  reader;
+                std::vector<uint64_t>      starts; // Posição dos primeiros símbolos
+                std::vector<unsigned char> data;
+                bool                       valid = false;
+        };
+
+        auto position = [](const Chunk& chunk)
+        { return chunk.base + chunk.reader.GetPosition(); };
+
+        // Decodifica a parte a partir de `begin`, que é o início de um código apenas
+        // se `exact` for verdadeiro
+        auto decode = [&](Chunk& chunk, bool exact)
+        {
+            uint64_t byte = chunk.begin / BYTE_SIZE;
 
-        std::bitset<BYTE_SIZE> bits;
-        std::string            bufferRead;
-        std::string            bufferWrite;
-        unsigned char          byte;
-        std::size_t            bufferPosition = 0;
+            chunk.base   = byte * BYTE_SIZE;
+            chunk.reader = BitReader(payload + byte, payloadBytes - byte);
+            chunk.starts.clear();
+            chunk.data.clear();
 
-        unsigned char* buffer = new unsigned char[BUFFER_MAX_SIZE];
+            chunk.reader.Refill();
+            chunk.reader.Consume(chunk.begin % BYTE_SIZE);
 
-        std::streampos endReadPosition = static_cast<std::streamoff>(binSize) - 1;
+            uint64_t end = chunk.end - chunk.base;
 
-        auto decodeTime = std::chrono::high_resolution_clock::now();
-        while (bin.read((char*)buffer, BUFFER_MAX_SIZE) or bin.gcount() > 0)
+            while (not exact and chunk.starts.size() < SPECULATIVE_SYNC_SYMBOLS and
+                   chunk.reader.GetPosition() < end)
+            {
+                chunk.starts.push_back(position(chunk));
+
+                chunk.reader.Refill();
+                int32_t symbol = decoder.DecodeSymbol(chunk.reader);
+
+                if (symbol < 0)
+                {
+                    chunk.valid = false;
+                    return;
+                }
+
+                chunk.data.push_back(static_cast<unsigned char>(symbol));
+            }
+
+            chunk.valid = decoder.DecodeUntil(chunk.reader, end, chunk.data) and
+                          position(chunk) <= payloadBits;
+        };
+
+        uint64_t           chunkBits = SPECULATIVE_CHUNK_SIZE * BYTE_SIZE;
+        std::vector<Chunk> chunks(std::min<uint64_t>(
+            this->m_options.numThreads, (payloadBits + chunkBits - 1) / chunkBits));
+        uint64_t           begin = 0; // Início exato da rodada
+
+        numSymbols = 0;
+
+        // Cada rodada decodifica até numThreads partes. A primeira começa no fim
+        // exato da rodada anterior, e as demais são especulativas
+        while (begin < payloadBits)
         {
+            std::size_t numChunks = std::min<uint64_t>(
+                chunks.size(), (payloadBits - begin + chunkBits - 1) / chunkBits);
 
-            std::streampos currentReadPosition = bin.tellg();
+            std::vector<std::thread> threads;
 
-            for (std::size_t i = 0; i < bin.gcount(); i++)
+            for (std::size_t c = 0; c < numChunks; c++)
             {
-                byte = buffer[i];
-                bits = std::bitset<BYTE_SIZE>(byte);
+                chunks[c].begin = begin + c * chunkBits;
+                chunks[c].end   = std::min(chunks[c].begin + chunkBits, payloadBits);
+
+                threads.emplace_back(decode, std::ref(chunks[c]), c == 0);
+            }
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            // Parte cuja decodificação é a sequencial, a partir do símbolo `first`
+            Chunk*      current = &chunks[0];
+            std::size_t first   = 0;
 
-                bufferRead += bits.to_string();
+            if (not current->valid)
+                return false;
 
-                while (bufferPosition < bufferRead.size())
+            for (std::size_t c = 1; c < numChunks; c++)
+            {
+                Chunk&      next   = chunks[c];
+                std::size_t j      = 0;
+                bool        synced = false;
+
+                // Avança a decodificação correta, um símbolo por vez, até uma posição
+                // em que a especulativa também tenha começado um símbolo
+                while (next.valid)
                 {
-                    // Se estiver no último byte, itera somente sobre os bits válidos
-                    // Os bits inválidos (0's usados apenas para completar um byte e
-                    // possibilitar a gravação do último byte) causavam um percorrimento
-                    // na árvore e consequente inserção de um caractere aleatório no fim
-                    // do arquivo descompactado IF (o último byte está no buffer AND
-                    // está iterando no último byte AND e o último bit válido já foi
-                    // lido)
-                    if (currentReadPosition == endReadPosition and
-                        i == bin.gcount() - 1 and
-                        bufferPosition == bufferRead.size() - junkBitsOnLastByte)
-                        break;
+                    uint64_t p = position(*current);
 
-                    bufferRead[bufferPosition++] == '1'
-                        ? current = current->GetRightNode()
-                        : current = current->GetLeftNode();
+                    while (j < next.starts.size() and next.starts[j] < p)
+                        j++;
 
-                    // Check if node is an leaf
-                    if (not(current->GetLeftNode() or current->GetRightNode()))
-                    {
-                        bufferWrite += current->GetValue().GetBits();
-                        current = this->m_trie.GetRoot();
+                    if (j == next.starts.size())
+                        break;
 
-                        bufferRead     = bufferRead.substr(bufferPosition);
-                        bufferPosition = 0;
+                    if (next.starts[j] == p)
+                    {
+                        synced = true;
+                        break;
                     }
+
+                    current->reader.Refill();
+                    int32_t symbol = decoder.DecodeSymbol(current->reader);
+
+                    if (symbol < 0)
+                        return false;
+
+                    current->data.push_back(static_cast<unsigned char>(symbol));
                 }
+
+                if (synced)
+                {
+                    output.write((char*)current->data.data() + first,
+                                 current->data.size() - first);
+                    numSymbols += current->data.size() - first;
+
+                    current = &next;
+                    first   = j;
+                    continue;
+                }
+
+                // Sem sincronização, a decodificação correta segue pela parte
+                if (not decoder.DecodeUntil(current->reader,
+                                            next.end - current->base,
+                                            current->data))
+                    return false;
             }
 
-            if (bufferWrite.size() >= BUFFER_MAX_SIZE)
-                this->WriteBuffer(decompress, bufferWrite);
+            output.write((char*)current->data.data() + first,
+                         current->data.size() - first);
+            numSymbols += current->data.size() - first;
+
+            begin = position(*current);
         }
 
-        if (not bufferWrite.empty())
-            this->WriteBuffer(decompress, bufferWrite);
+        return begin == payloadBits;
+    }
 
-        delete[] buffer;
-        decompress.close();
-        bin.close();
+    bool Compress::DecodeBlock(const unsigned char* data,
+                               std::size_t          size,
+                               Format               format,
+                               unsigned char*       output,
+                               std::size_t          rawSize,
+                               uint64_t&            tableBits,
+                               uint64_t&            payloadBits,
+                               uint64_t&            numSymbols) const
+    {
+        std::vector<Code>     codes;
+        std::vector<uint32_t> symbols;
+        HuffmanDecoder        decoder;
+        BitReader             reader(data, size);
 
-        auto end = std::chrono::high_resolution_clock::now();
-        std::cout << "Descompressão do arquivo: " << std::fixed
-                  << std::chrono::duration_cast<std::chrono::duration<double>>(
-                         end - decodeTime)
-                  << std::endl;
+        if (not ReadCodeLengths(reader, codes, symbols) or
+            not decoder.Build(ListCodes(codes)))
+            return false;
+
+        std::vector<SymbolBytes> sequences(symbols.size());
+        std::transform(symbols.begin(), symbols.end(), sequences.begin(), ToBytes);
+
+        // No alfabeto de bytes, cada símbolo é um byte da saída
+        auto decode = [&](auto& readers)
+        {
+            if (not symbols.empty())
+                return decoder.Decode(readers, rawSize, output, sequences, numSymbols);
+
+            numSymbols = rawSize;
+            return decoder.Decode(readers, rawSize, output);
+        };
+
+        if (format != Format::INTERLEAVED)
+        {
+            tableBits = reader.GetPosition();
+
+            // Depois do fim do bloco, o leitor retorna 0s. Um bloco válido nunca os
+            // consome
+            if (not decode(reader) or reader.GetPosition() > uint64_t(size) * BYTE_SIZE)
+                return false;
+
+            payloadBits = reader.GetPosition() - tableBits;
+            return true;
+        }
+
+        // Tamanhos dos fluxos, após a tabela. O último ocupa o restante do bloco
+        uint8_t     last = INTERLEAVED_STREAMS - 1;
+        std::size_t offset =
+            reader.GetPosition() / BYTE_SIZE + last * BLOCK_FIELD_SIZE_IN_BYTES;
+        std::size_t sizes[INTERLEAVED_STREAMS];
+
+        if (offset > size)
+            return false;
+
+        sizes[last] = size - offset;
+
+        for (uint8_t s = 0; s < last; s++)
+        {
+            reader.Refill();
+            sizes[s] = reader.Peek(BYTE_SIZE * BLOCK_FIELD_SIZE_IN_BYTES);
+            reader.Consume(BYTE_SIZE * BLOCK_FIELD_SIZE_IN_BYTES);
+
+            if (sizes[s] > sizes[last])
+                return false;
+
+            sizes[last] -= sizes[s];
+        }
+
+        tableBits = reader.GetPosition();
+
+        InterleavedReaders readers;
+
+        for (uint8_t s = 0; s < INTERLEAVED_STREAMS; s++)
+        {
+            readers[s] = BitReader(data + offset, sizes[s]);
+            offset += sizes[s];
+        }
+
+        if (not decode(readers))
+            return false;
+
+        payloadBits = 0;
+
+        for (uint8_t s = 0; s < INTERLEAVED_STREAMS; s++)
+        {
+            if (readers[s].GetPosition() > uint64_t(sizes[s]) * BYTE_SIZE)
+                return false;
+
+            payloadBits += readers[s].GetPosition();
+        }
+
+        return true;
     }
 
-    dlkd::Node<TrieInfo>* Compress::RebuildTrie(std::ifstream& file,
-                                                Vector<bool>&  headerData,
-                                                std::size_t&   pos,
-                                                std::size_t&   numNodes)
+    bool Compress::ReadBlockDirectory(std::istream&            bin,
+                                      uint32_t                 blockSize,
+                                      std::vector<BlockEntry>& directory)
     {
-        if (pos + 7 >= headerData.Size())
-            return nullptr;
+        while (true)
+        {
+            BlockEntry entry;
+
+            if (not ReadBlockField(bin, entry.rawSize) or
+                not ReadBlockField(bin, entry.compressedSize) or
+                entry.rawSize > blockSize or
+                entry.compressedSize > BlockBound(entry.rawSize))
+                return false;
 
-        if (headerData[++pos])
+            // Marcador de fim
+            if (entry.rawSize == 0)
+                return entry.compressedSize == 0;
+
+            // Pula o conteúdo do bloco, que será lido durante a descompressão
+            entry.offset = bin.tellg();
+            directory.push_back(entry);
+
+            if (not bin.seekg(entry.compressedSize, std::ios::cur))
+                return false;
+        }
+    }
+
+    void Compress::DecodeBlocks(InputFile&    input,
+                                Format        format,
+                                std::ostream& output,
+                                std::string   filename)
+    {
+        std::istream&           bin = input.GetStream();
+        uint32_t                blockSize;
+        std::vector<BlockEntry> directory;
+
+        if (not ReadBlockField(bin, blockSize) or blockSize < BLOCK_MIN_SIZE or
+            blockSize > BLOCK_MAX_SIZE)
+            throw huffexcpt::CorruptedFile(filename);
+
+        // Com o arquivo mapeado, o diretório de blocos é lido antes da descompressão
+        // e cada bloco é lido diretamente do mapeamento. Caso contrário (pipes), os
+        // blocos são lidos da stream em sequência
+        if (input.IsMapped() and not ReadBlockDirectory(bin, blockSize, directory))
+            throw huffexcpt::CorruptedFile(filename);
+
+        // Cada thread lê o próximo bloco e o descomprime em uma região do tamanho
+        // registrado no formato. A thread atual escreve as regiões na ordem do
+        // arquivo à medida que ficam prontas. No máximo `window` blocos ficam em
+        // memória ao mesmo tempo
+        struct DecodedBlock
         {
-            // Nó folha
-            std::size_t charSize = 0;
-            std::string charDecoding;
-
-            // Possibilidades do primeiro byte
-            // 0xxxxxxx -> 8  bits
-            // 110xxxxx -> 16 bits
-            // 1110xxxx -> 24 bits
-            // 11110xxx -> 32 bits
-            if (headerData[++pos] == 0)
-            {                                 // 0x
-                charSize     = BYTE_SIZE - 1; // subtrair a quantidade de bits já lidos
-                charDecoding = "0";
+                std::vector<unsigned char> data;
+                bool                       ready = false;
+        };
+
+        std::size_t numThreads = this->m_options.numThreads;
+        if (input.IsMapped())
+            numThreads =
+                std::max<std::size_t>(1, std::min(numThreads, directory.size()));
+
+        std::size_t               window = 2 * numThreads;
+        std::vector<DecodedBlock> blocks(window);
+
+        std::mutex              mutex;
+        std::condition_variable condition;
+        std::size_t             nextRead  = 0;
+        std::size_t             nextWrite = 0;
+        bool                    endOfFile = false;
+        bool                    failed    = false;
+
+        // Medições somadas por todas as threads
+        std::atomic<uint64_t> compressedBytes(0);
+        std::atomic<uint64_t> tableBits(0);
+        std::atomic<uint64_t> payloadBits(0);
+        std::atomic<uint64_t> numSymbols(0);
+
+        // Obtém o próximo bloco, com o mutex travado. Retorna falso no marcador de
+        // fim ou se o bloco estiver corrompido
+        auto next = [&](BlockEntry&                 entry,
+                        std::vector<unsigned char>& body,
+                        const unsigned char*&       data)
+        {
+            if (input.IsMapped())
+            {
+                if (nextRead == directory.size())
+                    return false;
+
+                // O diretório garante que o bloco está dentro do mapeamento
+                entry = directory[nextRead];
+                data  = input.GetData() + entry.offset;
+                return true;
             }
-            else
-            {          // 11x...
-                pos++; // Com certeza o próximo bit é 1
-                if (headerData[++pos] == 0)
-                { // 110x...
-                    charSize     = BYTE_SIZE * 2 - 3;
-                    charDecoding = "110";
-                }
-                else if (headerData[++pos] == 0)
-                { // 1110x..
-                    charSize     = BYTE_SIZE * 3 - 4;
-                    charDecoding = "1110";
+
+            if (not ReadBlockField(bin, entry.rawSize) or
+                not ReadBlockField(bin, entry.compressedSize) or
+                entry.rawSize > blockSize or
+                entry.compressedSize > BlockBound(entry.rawSize))
+            {
+                failed = true;
+                return false;
+            }
+
+            if (entry.rawSize == 0)
+            {
+                failed = entry.compressedSize != 0;
+                return false;
+            }
+
+            body.resize(entry.compressedSize);
+
+            if (not bin.read((char*)body.data(), entry.compressedSize))
+            {
+                failed = true;
+                return false;
+            }
+
+            data = body.data();
+            return true;
+        };
+
+        auto worker = [&]()
+        {
+            std::vector<unsigned char> body;
+
+            while (true)
+            {
+                std::size_t          index;
+                BlockEntry           entry;
+                const unsigned char* data;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock,
+                                   [&]()
+                                   {
+                                       return failed or endOfFile or
+                                              nextRead < nextWrite + window;
+                                   });
+
+                    if (failed or endOfFile)
+                        return;
+
+                    if (not next(entry, body, data))
+                    {
+                        endOfFile = true;
+                        condition.notify_all();
+                        return;
+                    }
+
+                    index = nextRead++;
                 }
-                else
-                { // 11110x...
-                    pos++;
-                    charSize     = BYTE_SIZE * 4 - 5;
-                    charDecoding = "11110";
+
+                DecodedBlock& decoded = blocks[index % window];
+                decoded.data.resize(entry.rawSize);
+
+                uint64_t blockTableBits;
+                uint64_t blockPayloadBits;
+                uint64_t blockSymbols;
+                bool     valid = this->DecodeBlock(data,
+                                               entry.compressedSize,
+                                               format,
+                                               decoded.data.data(),
+                                               entry.rawSize,
+                                               blockTableBits,
+                                               blockPayloadBits,
+                                               blockSymbols);
+
+                input.Release(data, entry.compressedSize);
+
+                compressedBytes += entry.compressedSize;
+                tableBits += blockTableBits;
+                payloadBits += blockPayloadBits;
+                numSymbols += blockSymbols;
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    if (valid)
+                        decoded.ready = true;
+                    else
+                        failed = true;
                 }
+
+                condition.notify_all();
             }
+        };
 
-            if (pos + charSize <= headerData.Size())
-            { // Ainda existem dados do cabeçalho para serem lidos
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < numThreads; i++)
+            threads.emplace_back(worker);
 
-                // Armazena a sequência de bits em uma string
-                for (std::size_t j = 0; j < charSize; j++)
-                    headerData[++pos] ? charDecoding += "1" : charDecoding += "0";
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            DecodedBlock&                decoded = blocks[nextWrite % window];
+
+            condition.wait(lock,
+                           [&]()
+                           {
+                               return failed or decoded.ready or
+                                      (endOfFile and nextWrite == nextRead);
+                           });
+
+            if (failed or not decoded.ready)
+                break;
+
+            // Nenhuma outra thread usa o bloco até que ele seja liberado
+            lock.unlock();
+
+            output.write((char*)decoded.data.data(), decoded.data.size());
+            this->m_metrics.outputBytes += decoded.data.size();
+
+            lock.lock();
+            decoded.ready = false;
+            nextWrite++;
+            condition.notify_all();
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
 
-                // Nó folha
-                // Por default a frequência de cada caractere é 0 (não tem essa
-                // informação na reconstrução da trie)
-                numNodes++;
-                return new dlkd::Node<TrieInfo>(TrieInfo(charDecoding, 0));
+        if (failed)
+            throw huffexcpt::CorruptedFile(filename);
+
+        // Assinatura, tamanho dos blocos e campos de tamanho de cada bloco e do
+        // marcador de fim
+        uint64_t fieldBytes = BLOCK_SIGNATURE.size() + BLOCK_FIELD_SIZE_IN_BYTES +
+                              2 * BLOCK_FIELD_SIZE_IN_BYTES * (nextWrite + 1);
+
+        this->m_metrics.inputBytes  = fieldBytes + compressedBytes;
+        this->m_metrics.numSymbols  = numSymbols;
+        this->m_metrics.headerBits  = fieldBytes * BYTE_SIZE + tableBits;
+        this->m_metrics.payloadBits = payloadBits;
+    }
+
+    uint64_t Compress::BlockBound(uint32_t rawSize)
+    {
+        // Tabela de comprimentos e códigos de até BIT_READER_MIN_BITS bits. Cada
+        // símbolo ocupa menos de 3 bytes na tabela do alfabeto de bytes e menos de 6
+        // na do alfabeto de code points, que tem no máximo um símbolo por byte. No
+        // formato intercalado, há também os tamanhos dos fluxos e o preenchimento do
+        // último byte de cada um
+        uint64_t numCodePoints = std::min<uint64_t>(rawSize, CODE_POINT_MAX_SYMBOLS);
+        uint64_t tableBytes    = std::max<uint64_t>(3 * ALPHABET_SIZE + 2,
+                                                 6 * numCodePoints + 3);
+        uint64_t streamBytes   = INTERLEAVED_STREAMS * (BLOCK_FIELD_SIZE_IN_BYTES + 1);
+
+        return tableBytes + streamBytes +
+               (uint64_t(rawSize) * BIT_READER_MIN_BITS + BYTE_SIZE - 1) / BYTE_SIZE;
+    }
+
+    void Compress::Decode(std::string binFile)
+    {
+        // Com a entrada padrão, o arquivo descomprimido é escrito na saída padrão
+        bool streaming = binFile == STREAM_NAME;
+
+        if (not streaming)
+            Parser::CheckDecodeCompatibility(binFile);
+
+        InputFile     input(binFile);
+        std::istream& bin = input.GetStream();
+
+        std::filesystem::path filePath(binFile);
+
+        std::string extension = filePath.extension().string();
+        if (extension.length() >= 4 &&
+            extension.substr(extension.length() - 4) == ".bin")
+            filePath.replace_extension("");
+
+        std::string originalExtension = filePath.extension().string();
+
+        std::string outputFileName =
+            filePath.parent_path() /
+            (filePath.stem().string() + "-decompressed" + originalExtension);
+        // A assinatura é verificada antes da criação do arquivo descomprimido
+        Format format;
+        if (not Parser::CheckSignature(bin, format))
+            throw huffexcpt::InvalidSignature(binFile);
+
+        std::ofstream file;
+        std::ostream  decompress(std::cout.rdbuf());
+
+        if (not streaming)
+        {
+            file.open(outputFileName, std::ios::binary);
+
+            if (not file.is_open())
+                throw huffexcpt::CouldNotOpenFile(outputFileName);
+
+            decompress.rdbuf(file.rdbuf());
+        }
+
+        this->m_metrics          = Metrics();
+        this->m_metrics.compress = false;
+
+        auto decodeTime = std::chrono::high_resolution_clock::now();
+        this->StartPhase();
+
+        try
+        {
+            // Os formatos com uma única tabela são lidos pelo caminho legado
+            if (format == Format::BLOCK or format == Format::INTERLEAVED)
+                this->DecodeBlocks(input, format, decompress, binFile);
+            else
+                this->DecodeSingleTable(input, format, decompress, binFile);
+        }
+        catch (...)
+        {
+            // Não deixa um arquivo descomprimido incompleto para trás (por exemplo,
+            // quando o binário está corrompido)
+            if (not streaming)
+            {
+                file.close();
+                std::filesystem::remove(outputFileName);
             }
+
+            throw;
+        }
+
+        decompress.flush();
+        file.close();
+
+        this->EndPhase(Phase::DECODE);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        this->m_metrics.totalSeconds =
+            std::chrono::duration<double>(end - decodeTime).count();
+    }
+
+    uint16_t
+    Compress::RebuildTrie(BitReader& reader, uint64_t headerBits, uint16_t depth)
+    {
+        // Uma trie válida nunca é mais profunda que o tamanho do alfabeto, então um
+        // cabeçalho corrompido não esgota a pilha
+        if (reader.GetPosition() >= headerBits or depth >= ALPHABET_SIZE)
+            return TREE_NULL;
+
+        reader.Refill();
+        bool leaf = reader.Peek(1);
+        reader.Consume(1);
+
+        if (leaf)
+        {
+            // Nó folha
+            // Cada símbolo é gravado com exatamente um byte pelo codificador, então a
+            // folha é lida byte a byte, sem interpretar o primeiro byte como o início
+            // de uma sequência UTF-8
+            if (reader.GetPosition() + BYTE_SIZE > headerBits)
+                return TREE_NULL;
+
+            uint16_t symbol = reader.Peek(BYTE_SIZE);
+            reader.Consume(BYTE_SIZE);
+
+            // Por default a frequência de cada caractere é 0 (não tem essa
+            // informação na reconstrução da trie)
+            return this->m_trie.AddLeaf(symbol, 0);
         }
         else
         {
             // Nó interno
-            numNodes++;
-            dlkd::Node<TrieInfo>* leftChild =
-                this->RebuildTrie(file, headerData, pos, numNodes);
-            dlkd::Node<TrieInfo>* rightChild =
-                this->RebuildTrie(file, headerData, pos, numNodes);
+            uint16_t leftChild  = this->RebuildTrie(reader, headerBits, depth + 1);
+            uint16_t rightChild = this->RebuildTrie(reader, headerBits, depth + 1);
 
-            return new dlkd::Node<TrieInfo>(TrieInfo("", 0), leftChild, rightChild);
+            return this->m_trie.AddNode(leftChild, rightChild, 0);
         }
-
-        return nullptr;
     }
 
 } // namespace huff
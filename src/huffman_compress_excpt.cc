@@ -16,9 +16,11 @@ const char* huffexcpt::CouldNotOpenFile::what() const throw()
     return this->m_msg.c_str();
 }
 
-huffexcpt::IsNotUTF8Encoding::IsNotUTF8Encoding(std::string file)
+huffexcpt::IsNotUTF8Encoding::IsNotUTF8Encoding(std::string file, uint64_t offset)
 {
-    this->m_msg = "ERRO: O arquivo '" + file + "' não está codificado como UTF-8";
+    this->m_msg = "ERRO: O arquivo '" + file +
+                  "' não está codificado como UTF-8 (byte inválido na posição " +
+                  std::to_string(offset) + ")";
 }
 
 const char* huffexcpt::IsNotUTF8Encoding::what() const throw()
@@ -46,3 +48,35 @@ const char* huffexcpt::FileIsEmpty::what() const throw()
 {
     return this->m_msg.c_str();
 }
+
+huffexcpt::CorruptedFile::CorruptedFile(std::string file)
+{
+    this->m_msg = "ERRO: O arquivo '" + file + "' está corrompido.";
+}
+
+const char* huffexcpt::CorruptedFile::what() const throw()
+{
+    return this->m_msg.c_str();
+}
+
+huffexcpt::InputNotSeekable::InputNotSeekable(std::string file)
+{
+    this->m_msg = "ERRO: O arquivo '" + file +
+                  "' não pode ser lido duas vezes. Use o formato em blocos (-f block).";
+}
+
+const char* huffexcpt::InputNotSeekable::what() const throw()
+{
+    return this->m_msg.c_str();
+}
+
+huffexcpt::InvalidMaxCodeLength::InvalidMaxCodeLength(unsigned maxCodeLength)
+{
+    this->m_msg = "ERRO: Os símbolos do arquivo não cabem em códigos de " +
+                  std::to_string(maxCodeLength) + " bits.";
+}
+
+const char* huffexcpt::InvalidMaxCodeLength::what() const throw()
+{
+    return this->m_msg.c_str();
+}
@@ -0,0 +1,601 @@
+/*
+ * Filename: huffman_decoder.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "huffman_decoder.h"
+#include "huffman_compress.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace huff
+{
+    HuffmanDecoder::HuffmanDecoder()
+        : m_tableBits(0),
+          m_minLength(0),
+          m_maxLength(0)
+    { }
+
+    bool HuffmanDecoder::Build(const std::vector<SymbolCode>& codes)
+    {
+        this->m_minLength = BIT_READER_MIN_BITS;
+        this->m_maxLength = 0;
+        for (const SymbolCode& sc : codes)
+        {
+            if (sc.code.length == 0 or sc.code.length > BIT_READER_MIN_BITS)
+                return false;
+
+            this->m_minLength = std::min(this->m_minLength, sc.code.length);
+            this->m_maxLength = std::max(this->m_maxLength, sc.code.length);
+        }
+
+        if (this->m_maxLength == 0)
+            return false;
+
+        this->m_tableBits = std::min(DECODE_TABLE_BITS, this->m_maxLength);
+        this->m_table.assign(std::size_t(1) << this->m_tableBits, Entry());
+
+        // O intervalo 0 é vazio e representa os prefixos que não pertencem a nenhum
+        // código
+        this->m_longCodes.clear();
+        this->m_longRanges.assign(1, LongRange());
+
+        for (const SymbolCode& sc : codes)
+        {
+            if (sc.code.length > this->m_tableBits)
+            {
+                this->m_longCodes.push_back(sc);
+                continue;
+            }
+
+            // Todas as entradas que começam com o código apontam para o símbolo
+            uint8_t     freeBits = this->m_tableBits - sc.code.length;
+            std::size_t first    = sc.code.bits << freeBits;
+
+            for (std::size_t i = 0; i < (std::size_t(1) << freeBits); i++)
+                this->m_table[first + i] = Entry { sc.symbol, sc.code.length };
+        }
+
+        // Agrupa os códigos longos pelo prefixo, do menor para o maior código
+        auto prefix = [this](const SymbolCode& sc)
+        { return sc.code.bits >> (sc.code.length - this->m_tableBits); };
+
+        std::sort(this->m_longCodes.begin(),
+                  this->m_longCodes.end(),
+                  [&prefix](const SymbolCode& a, const SymbolCode& b)
+                  {
+                      if (prefix(a) != prefix(b))
+                          return prefix(a) < prefix(b);
+
+                      return a.code.length < b.code.length;
+                  });
+
+        for (std::size_t i = 0; i < this->m_longCodes.size();)
+        {
+            LongRange range { static_cast<uint32_t>(i), static_cast<uint32_t>(i) };
+
+            while (range.end < this->m_longCodes.size() and
+                   prefix(this->m_longCodes[range.end]) ==
+                       prefix(this->m_longCodes[i]))
+                range.end++;
+
+            this->m_table[prefix(this->m_longCodes[i])] =
+                Entry { static_cast<uint16_t>(this->m_longRanges.size()), 0 };
+            this->m_longRanges.push_back(range);
+
+            i = range.end;
+        }
+
+        this->BuildMulti(codes);
+
+        return true;
+    }
+
+    void HuffmanDecoder::BuildMulti(const std::vector<SymbolCode>& codes)
+    {
+        this->m_multiTable.clear();
+
+        // As entradas guardam os símbolos como bytes
+        for (const SymbolCode& sc : codes)
+            if (sc.symbol >= ALPHABET_SIZE)
+                return;
+
+        // A tabela de um símbolo pode ser menor que DECODE_TABLE_BITS, quando todos
+        // os códigos são curtos, e é consultada com os bits mais significativos
+        std::size_t             size  = std::size_t(1) << DECODE_TABLE_BITS;
+        uint8_t                 shift = DECODE_TABLE_BITS - this->m_tableBits;
+        std::vector<MultiEntry> table(size);
+        std::size_t             numSymbols = 0;
+
+        for (std::size_t index = 0; index < size; index++)
+        {
+            MultiEntry& multi = table[index];
+
+            // Decodifica os bits restantes do índice, completados com 0s, até que o
+            // próximo código não caiba inteiro nos bits do índice
+            while (multi.count < MULTI_DECODE_SYMBOLS)
+            {
+                std::size_t  bits  = (index << multi.length) & (size - 1);
+                const Entry& entry = this->m_table[bits >> shift];
+
+                if (entry.length == 0 or
+                    multi.length + entry.length > DECODE_TABLE_BITS)
+                    break;
+
+                multi.symbols[multi.count++] = static_cast<unsigned char>(entry.symbol);
+                multi.length += entry.length;
+            }
+
+            numSymbols += multi.count;
+        }
+
+        // Com as probabilidades implícitas nos comprimentos (2^-comprimento), todos
+        // os índices são igualmente prováveis, então a média das entradas é a
+        // quantidade esperada de símbolos por consulta
+        if (double(numSymbols) / size >= MULTI_DECODE_MIN_AVERAGE)
+            this->m_multiTable = std::move(table);
+    }
+
+    bool HuffmanDecoder::IsMultiSymbol() const
+    {
+        return not this->m_multiTable.empty();
+    }
+
+    int32_t HuffmanDecoder::DecodeLong(BitReader& reader, const Entry& entry) const
+    {
+        const LongRange& range = this->m_longRanges[entry.symbol];
+
+        for (uint32_t i = range.begin; i < range.end; i++)
+        {
+            const SymbolCode& sc = this->m_longCodes[i];
+
+            if (reader.Peek(sc.code.length) == sc.code.bits)
+            {
+                reader.Consume(sc.code.length);
+                return sc.symbol;
+            }
+        }
+
+        return -1;
+    }
+
+    bool HuffmanDecoder::Decode(BitReader&    reader,
+                                uint64_t      numBits,
+                                std::ostream& output,
+                                uint64_t&     numSymbols) const
+    {
+        if (this->IsMultiSymbol())
+            return this->DecodeMulti(reader, numBits, output, numSymbols);
+
+        std::vector<unsigned char> buffer(BUFFER_MAX_SIZE);
+        std::size_t                size = 0;
+
+        numSymbols = 0;
+
+        // Após uma recarga, é possível decodificar symbolsPerRefill símbolos sem
+        // consultar o leitor novamente. Isso é feito enquanto não houver risco de
+        // avançar sobre os bits inválidos do último byte
+        uint8_t  symbolsPerRefill = BIT_READER_MIN_BITS / this->m_maxLength;
+        uint64_t refillBits       = uint64_t(symbolsPerRefill) * this->m_maxLength;
+        uint64_t fastEnd          = numBits > refillBits ? numBits - refillBits : 0;
+
+        while (reader.GetPosition() < fastEnd)
+        {
+            reader.Refill();
+
+            for (uint8_t k = 0; k < symbolsPerRefill; k++)
+            {
+                int32_t symbol = this->DecodeSymbol(reader);
+
+                if (symbol < 0)
+                    return false;
+
+                buffer[size++] = static_cast<unsigned char>(symbol);
+            }
+
+            if (size + symbolsPerRefill > buffer.size())
+            {
+                output.write((char*)buffer.data(), size);
+                numSymbols += size;
+                size = 0;
+            }
+        }
+
+        while (reader.GetPosition() < numBits)
+        {
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0)
+                return false;
+
+            buffer[size++] = static_cast<unsigned char>(symbol);
+
+            if (size == buffer.size())
+            {
+                output.write((char*)buffer.data(), size);
+                numSymbols += size;
+                size = 0;
+            }
+        }
+
+        output.write((char*)buffer.data(), size);
+        numSymbols += size;
+
+        return reader.GetPosition() == numBits;
+    }
+
+    bool HuffmanDecoder::Decode(BitReader&     reader,
+                                std::size_t    numSymbols,
+                                unsigned char* output) const
+    {
+        if (this->IsMultiSymbol())
+            return this->DecodeMulti(reader, numSymbols, output);
+
+        uint8_t     symbolsPerRefill = BIT_READER_MIN_BITS / this->m_maxLength;
+        std::size_t i                = 0;
+
+        while (i + symbolsPerRefill <= numSymbols)
+        {
+            reader.Refill();
+
+            for (uint8_t k = 0; k < symbolsPerRefill; k++)
+            {
+                int32_t symbol = this->DecodeSymbol(reader);
+
+                if (symbol < 0)
+                    return false;
+
+                output[i++] = static_cast<unsigned char>(symbol);
+            }
+        }
+
+        while (i < numSymbols)
+        {
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0)
+                return false;
+
+            output[i++] = static_cast<unsigned char>(symbol);
+        }
+
+        return true;
+    }
+
+    bool HuffmanDecoder::DecodeMulti(BitReader&    reader,
+                                     uint64_t      numBits,
+                                     std::ostream& output,
+                                     uint64_t&     numSymbols) const
+    {
+        std::vector<unsigned char> buffer(BUFFER_MAX_SIZE);
+        std::size_t                size = 0;
+
+        numSymbols = 0;
+
+        // Após uma recarga, as consultas continuam enquanto restarem no acumulador
+        // bits para a maior delas, de modo que a recarga consome no máximo
+        // BIT_READER_MIN_BITS bits. Isso é feito enquanto não houver risco de avançar
+        // sobre os bits inválidos do último byte. Cada símbolo consome ao menos um
+        // bit, então uma recarga produz no máximo BIT_READER_MIN_BITS símbolos
+        uint8_t     maxStep = std::max(DECODE_TABLE_BITS, this->m_maxLength);
+        uint64_t    fastEnd = numBits > BIT_READER_MIN_BITS
+                                  ? numBits - BIT_READER_MIN_BITS
+                                  : 0;
+        std::size_t margin  = BIT_READER_MIN_BITS + MULTI_DECODE_SYMBOLS;
+
+        while (reader.GetPosition() < fastEnd)
+        {
+            reader.Refill();
+
+            uint64_t last = reader.GetPosition() + BIT_READER_MIN_BITS - maxStep;
+
+            do
+            {
+                uint8_t count = this->DecodeSymbols(reader, buffer.data() + size);
+
+                if (count == 0)
+                    return false;
+
+                size += count;
+            } while (reader.GetPosition() <= last);
+
+            if (size + margin > buffer.size())
+            {
+                output.write((char*)buffer.data(), size);
+                numSymbols += size;
+                size = 0;
+            }
+        }
+
+        while (reader.GetPosition() < numBits)
+        {
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0)
+                return false;
+
+            buffer[size++] = static_cast<unsigned char>(symbol);
+
+            if (size == buffer.size())
+            {
+                output.write((char*)buffer.data(), size);
+                numSymbols += size;
+                size = 0;
+            }
+        }
+
+        output.write((char*)buffer.data(), size);
+        numSymbols += size;
+
+        return reader.GetPosition() == numBits;
+    }
+
+    bool HuffmanDecoder::DecodeMulti(BitReader&     reader,
+                                     std::size_t    numSymbols,
+                                     unsigned char* output) const
+    {
+        // Como na versão para uma stream, uma recarga produz no máximo
+        // BIT_READER_MIN_BITS símbolos, e a última entrada grava até
+        // MULTI_DECODE_SYMBOLS bytes
+        uint8_t     maxStep = std::max(DECODE_TABLE_BITS, this->m_maxLength);
+        std::size_t margin  = BIT_READER_MIN_BITS + MULTI_DECODE_SYMBOLS;
+        std::size_t i       = 0;
+
+        while (i + margin <= numSymbols)
+        {
+            reader.Refill();
+
+            uint64_t last = reader.GetPosition() + BIT_READER_MIN_BITS - maxStep;
+
+            do
+            {
+                uint8_t count = this->DecodeSymbols(reader, output + i);
+
+                if (count == 0)
+                    return false;
+
+                i += count;
+            } while (reader.GetPosition() <= last);
+        }
+
+        while (i < numSymbols)
+        {
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0)
+                return false;
+
+            output[i++] = static_cast<unsigned char>(symbol);
+        }
+
+        return true;
+    }
+
+    bool HuffmanDecoder::Decode(BitReader&                      reader,
+                                std::size_t                     size,
+                                unsigned char*                  output,
+                                const std::vector<SymbolBytes>& sequences,
+                                uint64_t&                       numSymbols) const
+    {
+        uint8_t     symbolsPerRefill = BIT_READER_MIN_BITS / this->m_maxLength;
+        std::size_t refillBytes = std::size_t(symbolsPerRefill) * UTF8_MAX_SEQUENCE;
+        std::size_t i           = 0;
+
+        numSymbols = 0;
+
+        // Enquanto houver espaço para as maiores sequências de todos os símbolos de uma
+        // recarga, cada sequência é copiada inteira, sem consultar o seu tamanho
+        while (i + refillBytes <= size)
+        {
+            reader.Refill();
+
+            for (uint8_t k = 0; k < symbolsPerRefill; k++)
+            {
+                int32_t symbol = this->DecodeSymbol(reader);
+
+                if (symbol < 0)
+                    return false;
+
+                const SymbolBytes& sb = sequences[symbol];
+                std::memcpy(output + i, sb.bytes, UTF8_MAX_SEQUENCE);
+                i += sb.length;
+            }
+
+            numSymbols += symbolsPerRefill;
+        }
+
+        while (i < size)
+        {
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0 or i + sequences[symbol].length > size)
+                return false;
+
+            const SymbolBytes& sb = sequences[symbol];
+            std::memcpy(output + i, sb.bytes, sb.length);
+            i += sb.length;
+            numSymbols++;
+        }
+
+        return true;
+    }
+
+    bool HuffmanDecoder::DecodeUntil(BitReader&                  reader,
+                                     uint64_t                    end,
+                                     std::vector<unsigned char>& output) const
+    {
+        if (reader.GetPosition() >= end)
+            return true;
+
+        // Os símbolos começam antes de `end`, a pelo menos m_minLength bits um do
+        // outro, e a última entrada da tabela de vários símbolos grava até
+        // MULTI_DECODE_SYMBOLS bytes
+        std::size_t size = output.size();
+        output.resize(size + (end - reader.GetPosition()) / this->m_minLength + 1 +
+                      MULTI_DECODE_SYMBOLS);
+
+        // As recargas consomem no máximo BIT_READER_MIN_BITS bits, como em Decode
+        if (this->IsMultiSymbol())
+        {
+            uint8_t maxStep = std::max(DECODE_TABLE_BITS, this->m_maxLength);
+
+            while (reader.GetPosition() + BIT_READER_MIN_BITS <= end)
+            {
+                reader.Refill();
+
+                uint64_t last = reader.GetPosition() + BIT_READER_MIN_BITS - maxStep;
+
+                do
+                {
+                    uint8_t count = this->DecodeSymbols(reader, output.data() + size);
+
+                    if (count == 0)
+                        return false;
+
+                    size += count;
+                } while (reader.GetPosition() <= last);
+            }
+        }
+        else
+        {
+            uint8_t  symbolsPerRefill = BIT_READER_MIN_BITS / this->m_maxLength;
+            uint64_t refillBits = uint64_t(symbolsPerRefill) * this->m_maxLength;
+
+            while (reader.GetPosition() + refillBits <= end)
+            {
+                reader.Refill();
+
+                for (uint8_t k = 0; k < symbolsPerRefill; k++)
+                {
+                    int32_t symbol = this->DecodeSymbol(reader);
+
+                    if (symbol < 0)
+                        return false;
+
+                    output[size++] = static_cast<unsigned char>(symbol);
+                }
+            }
+        }
+
+        while (reader.GetPosition() < end)
+        {
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0)
+                return false;
+
+            output[size++] = static_cast<unsigned char>(symbol);
+        }
+
+        output.resize(size);
+        return true;
+    }
+
+    bool HuffmanDecoder::Decode(InterleavedReaders& readers,
+                                std::size_t         numSymbols,
+                                unsigned char*      output) const
+    {
+        uint8_t     symbolsPerRefill = BIT_READER_MIN_BITS / this->m_maxLength;
+        std::size_t step = std::size_t(symbolsPerRefill) * INTERLEAVED_STREAMS;
+        std::size_t i    = 0;
+
+        // Cada leitor é recarregado uma vez por passo, que tem symbolsPerRefill
+        // símbolos de cada fluxo
+        while (i + step <= numSymbols)
+        {
+            for (BitReader& reader : readers)
+                reader.Refill();
+
+            for (uint8_t k = 0; k < symbolsPerRefill; k++)
+            {
+                for (BitReader& reader : readers)
+                {
+                    int32_t symbol = this->DecodeSymbol(reader);
+
+                    if (symbol < 0)
+                        return false;
+
+                    output[i++] = static_cast<unsigned char>(symbol);
+                }
+            }
+        }
+
+        for (; i < numSymbols; i++)
+        {
+            BitReader& reader = readers[i % INTERLEAVED_STREAMS];
+
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0)
+                return false;
+
+            output[i] = static_cast<unsigned char>(symbol);
+        }
+
+        return true;
+    }
+
+    bool HuffmanDecoder::Decode(InterleavedReaders&             readers,
+                                std::size_t                     size,
+                                unsigned char*                  output,
+                                const std::vector<SymbolBytes>& sequences,
+                                uint64_t&                       numSymbols) const
+    {
+        uint8_t     symbolsPerRefill = BIT_READER_MIN_BITS / this->m_maxLength;
+        std::size_t refillBytes      = std::size_t(symbolsPerRefill) *
+                                  INTERLEAVED_STREAMS * UTF8_MAX_SEQUENCE;
+        std::size_t i = 0;
+
+        numSymbols = 0;
+
+        while (i + refillBytes <= size)
+        {
+            for (BitReader& reader : readers)
+                reader.Refill();
+
+            for (uint8_t k = 0; k < symbolsPerRefill; k++)
+            {
+                for (BitReader& reader : readers)
+                {
+                    int32_t symbol = this->DecodeSymbol(reader);
+
+                    if (symbol < 0)
+                        return false;
+
+                    const SymbolBytes& sb = sequences[symbol];
+                    std::memcpy(output + i, sb.bytes, UTF8_MAX_SEQUENCE);
+                    i += sb.length;
+                }
+            }
+
+            numSymbols += std::size_t(symbolsPerRefill) * INTERLEAVED_STREAMS;
+        }
+
+        // Os passos completos mantêm o próximo símbolo no primeiro fluxo
+        for (; i < size; numSymbols++)
+        {
+            BitReader& reader = readers[numSymbols % INTERLEAVED_STREAMS];
+
+            reader.Refill();
+            int32_t symbol = this->DecodeSymbol(reader);
+
+            if (symbol < 0 or i + sequences[symbol].length > size)
+                return false;
+
+            const SymbolBytes& sb = sequences[symbol];
+            std::memcpy(output + i, sb.bytes, sb.length);
+            i += sb.length;
+        }
+
+        return true;
+    }
+} // namespace huff
@@ -0,0 +1,75 @@
+/*
+ * Filename: huffman_tree.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "huffman_tree.h"
+
+namespace huff
+{
+    HuffmanTree::HuffmanTree(std::size_t alphabetSize)
+        // Uma árvore com n folhas tem 2n - 1 nós. Com um único símbolo, uma folha
+        // vizinha é acrescentada, o que ainda cabe nesse limite
+        : m_maxNodes(2 * alphabetSize - 1),
+          m_root(TREE_NULL)
+    {
+        this->m_nodes.reserve(this->m_maxNodes);
+    }
+
+    void HuffmanTree::Clear()
+    {
+        this->m_nodes.clear();
+        this->m_root = TREE_NULL;
+    }
+
+    uint16_t HuffmanTree::AddLeaf(uint16_t symbol, uint64_t frequency)
+    {
+        uint16_t leaf = this->AddNode(TREE_NULL, TREE_NULL, frequency);
+
+        if (leaf != TREE_NULL)
+            this->m_nodes[leaf].symbol = symbol;
+
+        return leaf;
+    }
+
+    uint16_t HuffmanTree::AddNode(uint16_t left, uint16_t right, uint64_t frequency)
+    {
+        if (this->m_nodes.size() == this->m_maxNodes)
+            return TREE_NULL;
+
+        this->m_nodes.push_back({ frequency, left, right, 0 });
+        return this->m_nodes.size() - 1;
+    }
+
+    bool HuffmanTree::IsLeaf(uint16_t index) const
+    {
+        const TreeNode& node = this->m_nodes[index];
+        return node.left == TREE_NULL and node.right == TREE_NULL;
+    }
+
+    const TreeNode& HuffmanTree::operator[](uint16_t index) const
+    {
+        return this->m_nodes[index];
+    }
+
+    TreeNode& HuffmanTree::operator[](uint16_t index)
+    {
+        return this->m_nodes[index];
+    }
+
+    uint16_t HuffmanTree::GetRoot() const
+    {
+        return this->m_root;
+    }
+
+    void HuffmanTree::SetRoot(uint16_t root)
+    {
+        this->m_root = root;
+    }
+
+    std::size_t HuffmanTree::Size() const
+    {
+        return this->m_nodes.size();
+    }
+} // namespace huff
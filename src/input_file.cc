@@ -0,0 +1,173 @@
+/*
+ * Filename: input_file.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "input_file.h"
+#include "huffman_compress.h"
+
+#include <algorithm>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace huff
+{
+    void InputFile::MappedBuffer::Assign(const unsigned char* data, std::size_t size)
+    {
+        char* begin = (char*)data;
+        this->setg(begin, begin, begin + size);
+    }
+
+    InputFile::MappedBuffer::pos_type
+    InputFile::MappedBuffer::seekoff(off_type                off,
+                                     std::ios_base::seekdir  dir,
+                                     std::ios_base::openmode which)
+    {
+        if (not(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+
+        off_type size   = this->egptr() - this->eback();
+        off_type target = off;
+
+        if (dir == std::ios_base::cur)
+            target += this->gptr() - this->eback();
+        else if (dir == std::ios_base::end)
+            target += size;
+
+        if (target < 0 or target > size)
+            return pos_type(off_type(-1));
+
+        this->setg(this->eback(), this->eback() + target, this->egptr());
+        return pos_type(target);
+    }
+
+    InputFile::MappedBuffer::pos_type
+    InputFile::MappedBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+    {
+        return this->seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+    InputFile::InputFile(const std::string& filename)
+        : m_data(nullptr),
+          m_size(0),
+          m_stream(nullptr)
+    {
+        // A entrada padrão também é mapeada quando redirecionada de um arquivo
+        // regular, desde que nada tenha sido lido dela
+        bool standardInput = filename == STREAM_NAME;
+        int  fd = standardInput ? STDIN_FILENO : open(filename.c_str(), O_RDONLY);
+
+        struct stat info;
+        if (fd >= 0 and fstat(fd, &info) == 0 and S_ISREG(info.st_mode) and
+            info.st_size > 0 and (not standardInput or lseek(fd, 0, SEEK_CUR) == 0))
+        {
+            void* map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (map != MAP_FAILED)
+            {
+                // O arquivo é percorrido do início ao fim: o kernel pode ler adiante
+                // e descartar as páginas já lidas
+                madvise(map, info.st_size, MADV_SEQUENTIAL);
+
+                this->m_data = static_cast<const unsigned char*>(map);
+                this->m_size = info.st_size;
+            }
+        }
+
+        // O mapeamento permanece válido após o fechamento do descritor
+        if (fd >= 0 and not standardInput)
+            close(fd);
+
+        if (this->m_data)
+        {
+            this->m_buffer.Assign(this->m_data, this->m_size);
+            this->m_stream.rdbuf(&this->m_buffer);
+            return;
+        }
+
+        if (standardInput)
+        {
+            this->m_stream.rdbuf(std::cin.rdbuf());
+            return;
+        }
+
+        this->m_file.open(filename, std::ios::binary);
+
+        if (not this->m_file.is_open())
+            throw huffexcpt::CouldNotOpenFile(filename);
+
+        this->m_stream.rdbuf(this->m_file.rdbuf());
+    }
+
+    InputFile::~InputFile()
+    {
+        if (this->m_data)
+            munmap((void*)this->m_data, this->m_size);
+    }
+
+    bool InputFile::IsMapped() const
+    {
+        return this->m_data != nullptr;
+    }
+
+    const unsigned char* InputFile::GetData() const
+    {
+        return this->m_data;
+    }
+
+    std::size_t InputFile::GetSize() const
+    {
+        return this->m_size;
+    }
+
+    std::istream& InputFile::GetStream()
+    {
+        return this->m_stream;
+    }
+
+    std::size_t InputFile::Read(unsigned char*        buffer,
+                                std::size_t           size,
+                                const unsigned char*& data)
+    {
+        if (not this->m_data)
+        {
+            this->m_stream.read((char*)buffer, size);
+            data = buffer;
+            return this->m_stream.gcount();
+        }
+
+        std::size_t pos =
+            this->m_buffer.pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+
+        size = std::min(size, this->m_size - pos);
+        data = this->m_data + pos;
+        this->m_buffer.pubseekoff(size, std::ios_base::cur, std::ios_base::in);
+
+        return size;
+    }
+
+    void InputFile::Release(const unsigned char* data, std::size_t size)
+    {
+        if (not this->m_data)
+            return;
+
+        // madvise só aceita endereços alinhados à página. As páginas compartilhadas
+        // com os trechos vizinhos são mantidas
+        uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+        uintptr_t begin    = ((uintptr_t)data + pageSize - 1) & ~(pageSize - 1);
+        uintptr_t end      = ((uintptr_t)data + size) & ~(pageSize - 1);
+
+        if (begin < end)
+            madvise((void*)begin, end - begin, MADV_DONTNEED);
+    }
+
+    bool InputFile::Rewind()
+    {
+        this->m_stream.clear();
+        return static_cast<bool>(this->m_stream.seekg(0, std::ios::beg));
+    }
+} // namespace huff
@@ -4,10 +4,13 @@
  * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
  */
 
+#include <cctype>
+#include <cerrno>
 #include <cstdlib>
 #include <exception>
 #include <getopt.h>
 #include <iostream>
+#include <limits>
 #include <string>
 
 #include "huffman_compress.h"
@@ -16,26 +19,85 @@ void PrintUsage()
 {
     std::cout << "Huffman Compress" << std::endl;
     std::cout << "Opções:" << std::endl;
-    std::cout << "  -c, --compress    Comprimir o arquivo" << std::endl;
-    std::cout << "  -d, --decompress  Descomprimir o arquivo" << std::endl;
+    std::cout << "  -c, --compress    Comprimir o arquivo ('-' para entrada/saída "
+                 "padrão)"
+              << std::endl;
+    std::cout << "  -d, --decompress  Descomprimir o arquivo ('-' para entrada/saída "
+                 "padrão)"
+              << std::endl;
+    std::cout << "  -T, --threads     Quantidade de threads (padrão: núcleos disponíveis)"
+              << std::endl;
+    std::cout << "  -f, --format      Formato do arquivo comprimido: legacy (padrão), "
+                 "canonical, block ou interleaved"
+              << std::endl;
+    std::cout << "  -b, --block-size  Tamanho dos blocos em kB, entre "
+              << BLOCK_MIN_SIZE / 1024 << " e " << BLOCK_MAX_SIZE / 1024
+              << " (padrão: " << BLOCK_DEFAULT_SIZE / 1024 << ")" << std::endl;
+    std::cout << "  -L, --max-code-len  Maior comprimento dos códigos em bits (padrão: "
+              << int(huff::BIT_READER_MIN_BITS) << ")" << std::endl;
+    std::cout << "  -B, --binary      Aceitar qualquer entrada, sem verificar se é UTF-8"
+              << std::endl;
+    std::cout << "  -s, --stats       Formato das medições: text (padrão) ou json"
+              << std::endl;
+    std::cout << "  -P, --perf-counters  Medir contadores de hardware de cada fase"
+              << std::endl;
     std::cout << "  -h, --help        Exibir esta mensagem de ajuda" << std::endl;
 }
 
+/**
+ * @brief Lê um número inteiro sem sinal em base 10. O texto inteiro deve ser o
+ *número: sinais, espaços e caracteres depois dos dígitos não são aceitos
+ * @param text Texto que será lido
+ * @param value Número lido
+ * @return Verdadeiro se o texto for um número que cabe em 64 bits
+ **/
+bool ParseUnsigned(const char* text, uint64_t& value)
+{
+    // strtoull aceita espaços e sinais no início, e nega os números negativos
+    if (not std::isdigit(static_cast<unsigned char>(text[0])))
+        return false;
+
+    char* end;
+    errno = 0;
+
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+
+    if (errno == ERANGE or *end != '\0')
+        return false;
+
+    value = parsed;
+    return true;
+}
+
 int main(int argc, char* argv[])
 {
+    // A entrada e a saída padrão podem transportar os dados ('-')
+    std::ios::sync_with_stdio(false);
+
     std::string fileToEncode;
     std::string fileToDecode;
 
-    const char* const shortOptions  = "c:d:h";
-    const option      longOptions[] = { { "compress", required_argument, nullptr, 'c' },
-                                        { "decompress", required_argument, nullptr, 'd' },
-                                        { "help", no_argument, nullptr, 'h' },
-                                        { nullptr, 0, nullptr, 0 } };
+    const char* const shortOptions  = "c:d:T:f:b:L:Bs:Ph";
+    const option      longOptions[] = {
+        { "compress", required_argument, nullptr, 'c' },
+        { "decompress", required_argument, nullptr, 'd' },
+        { "threads", required_argument, nullptr, 'T' },
+        { "format", required_argument, nullptr, 'f' },
+        { "block-size", required_argument, nullptr, 'b' },
+        { "max-code-len", required_argument, nullptr, 'L' },
+        { "binary", no_argument, nullptr, 'B' },
+        { "stats", required_argument, nullptr, 's' },
+        { "perf-counters", no_argument, nullptr, 'P' },
+        { "help", no_argument, nullptr, 'h' },
+        { nullptr, 0, nullptr, 0 }
+    };
 
-    int  option;
-    int  optionIndex = -1;
-    bool compress    = false;
-    bool decompress  = false;
+    int           option;
+    int           optionIndex = -1;
+    bool          compress    = false;
+    bool          decompress  = false;
+    bool          json        = false;
+    huff::Options options;
 
     while ((option =
                 getopt_long(argc, argv, shortOptions, longOptions, &optionIndex)) != -1)
@@ -50,6 +112,97 @@ int main(int argc, char* argv[])
                 decompress   = true;
                 fileToDecode = optarg;
                 break;
+            case 'T':
+            {
+                uint64_t numThreads;
+
+                if (not ParseUnsigned(optarg, numThreads) or numThreads == 0 or
+                    numThreads > std::numeric_limits<unsigned>::max())
+                {
+                    std::cerr << "ERRO: Quantidade de threads inválida '" << optarg
+                              << "'" << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                options.numThreads = numThreads;
+                break;
+            }
+            case 'f':
+                if (std::string(optarg) == "legacy")
+                    options.format = huff::Format::LEGACY;
+                else if (std::string(optarg) == "canonical")
+                    options.format = huff::Format::CANONICAL;
+                else if (std::string(optarg) == "block")
+                    options.format = huff::Format::BLOCK;
+                else if (std::string(optarg) == "interleaved")
+                    options.format = huff::Format::INTERLEAVED;
+                else
+                {
+                    std::cerr << "ERRO: Formato inválido '" << optarg << "'"
+                              << std::endl;
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'b':
+            {
+                uint64_t blockSize;
+
+                // O intervalo é verificado em kB, antes da multiplicação, que poderia
+                // transbordar
+                if (not ParseUnsigned(optarg, blockSize) or
+                    blockSize < BLOCK_MIN_SIZE / 1024 or
+                    blockSize > BLOCK_MAX_SIZE / 1024)
+                {
+                    std::cerr << "ERRO: Tamanho de bloco inválido '" << optarg
+                              << "' (deve estar entre " << BLOCK_MIN_SIZE / 1024
+                              << " e " << BLOCK_MAX_SIZE / 1024 << " kB)" << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                options.blockSize = blockSize * 1024;
+                break;
+            }
+            case 'L':
+            {
+                // Códigos menores que MIN_CODE_LENGTH não comportam todo o alfabeto
+                uint64_t maxCodeLength;
+
+                if (not ParseUnsigned(optarg, maxCodeLength) or
+                    maxCodeLength < MIN_CODE_LENGTH or
+                    maxCodeLength > huff::BIT_READER_MIN_BITS)
+                {
+                    std::cerr << "ERRO: Comprimento máximo de código inválido '"
+                              << optarg << "' (deve estar entre "
+                              << int(MIN_CODE_LENGTH) << " e "
+                              << int(huff::BIT_READER_MIN_BITS) << ")" << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                options.maxCodeLength = maxCodeLength;
+                break;
+            }
+            case 'B':
+                options.binary = true;
+                break;
+            case 's':
+                if (std::string(optarg) == "json")
+                    json = true;
+                else if (std::string(optarg) != "text")
+                {
+                    std::cerr << "ERRO: Formato de medições inválido '" << optarg
+                              << "'" << std::endl;
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'P':
+#ifdef HUFF_PERF_COUNTERS
+                options.perfCounters = true;
+                break;
+#else
+                std::cerr << "ERRO: Programa compilado sem contadores de hardware"
+                          << std::endl;
+                return EXIT_FAILURE;
+#endif
             case 'h':
                 PrintUsage();
                 return EXIT_SUCCESS;
@@ -59,8 +212,7 @@ int main(int argc, char* argv[])
         }
     }
 
-    std::string    outputFileName;
-    huff::Compress compressor;
+    huff::Compress compressor(options);
 
     if (not compress and not decompress)
     {
@@ -71,38 +223,26 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    // Quando a saída padrão recebe os dados, as medições vão para a saída de erro
+    auto report = [&](const std::string& file)
+    {
+        std::ostream& output = file == STREAM_NAME ? std::cerr : std::cout;
+
+        if (options.perfCounters and not compressor.GetMetrics().HasCounters())
+            std::cerr << "AVISO: Contadores de hardware indisponíveis" << std::endl;
+
+        if (json)
+            compressor.GetMetrics().PrintJson(output);
+        else
+            compressor.GetMetrics().PrintText(output);
+    };
+
     if (compress)
     {
         try
         {
             compressor.Encode(fileToEncode);
-
-            std::filesystem::path inputPath(fileToEncode);
-            std::string           outputFile = fileToEncode + ".bin";
-            std::ifstream         input(fileToEncode, std::ios::binary);
-            std::ifstream         output(outputFile, std::ios::binary);
-
-            if (input.is_open() and output.is_open())
-            {
-                input.seekg(0, std::ios::end);
-                std::streampos inputSize = input.tellg();
-
-                output.seekg(0, std::ios::end);
-                std::streampos outputSize = output.tellg();
-
-                if (inputSize > outputSize)
-                {
-                    double compressionRate =
-                        ((inputSize - outputSize) / static_cast<double>(inputSize)) *
-                        100;
-                    std::cout << std::fixed << std::setprecision(2);
-                    std::cout << "Taxa de compressão: " << compressionRate << "%"
-                              << std::endl;
-                }
-
-                input.close();
-                output.close();
-            }
+            report(fileToEncode);
         }
         catch (std::exception& e)
         {
@@ -116,6 +256,7 @@ int main(int argc, char* argv[])
         try
         {
             compressor.Decode(fileToDecode);
+            report(fileToDecode);
         }
         catch (std::exception& e)
         {
@@ -0,0 +1,225 @@
+/*
+ * Filename: metrics.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "metrics.h"
+#include "huffman_compress.h"
+
+#include <iomanip>
+
+namespace huff
+{
+    // Nome de cada fase no JSON e no texto, indexados pela fase
+    static const char* const PHASE_KEYS[]   = { "frequencies",
+                                                "trie",
+                                                "code",
+                                                "encode",
+                                                "decode" };
+    static const char* const PHASE_LABELS[] = { "Cálculo das Frequências",
+                                                "Construção da trie",
+                                                "Construção dos códigos",
+                                                "Compressão do arquivo",
+                                                "Descompressão do arquivo" };
+
+    // Nome de cada contador no JSON e no texto, indexados pelo contador
+    static const char* const COUNTER_KEYS[]   = { "cycles",
+                                                  "instructions",
+                                                  "branch_misses",
+                                                  "cache_misses",
+                                                  "l1d_misses" };
+    static const char* const COUNTER_LABELS[] = { "ciclos",
+                                                  "instruções",
+                                                  "branch misses",
+                                                  "cache misses",
+                                                  "L1D misses" };
+
+    static double InstructionsPerCycle(const CounterValues& counters)
+    {
+        if (counters.Get(Counter::CYCLES) == 0)
+            return 0;
+
+        return static_cast<double>(counters.Get(Counter::INSTRUCTIONS)) /
+               counters.Get(Counter::CYCLES);
+    }
+
+    void Metrics::AddPhase(Phase phase, double seconds, const CounterValues& counters)
+    {
+        for (PhaseMetrics& measured : this->phases)
+        {
+            if (measured.phase == phase)
+            {
+                measured.seconds += seconds;
+                measured.counters += counters;
+                return;
+            }
+        }
+
+        this->phases.push_back({ phase, seconds, counters });
+    }
+
+    bool Metrics::HasCounters() const
+    {
+        for (const PhaseMetrics& measured : this->phases)
+        {
+            if (measured.counters.available)
+                return true;
+        }
+
+        return false;
+    }
+
+    void Metrics::Merge(const Metrics& other)
+    {
+        for (const PhaseMetrics& measured : other.phases)
+            this->AddPhase(measured.phase, measured.seconds, measured.counters);
+
+        this->inputBytes += other.inputBytes;
+        this->outputBytes += other.outputBytes;
+        this->numSymbols += other.numSymbols;
+        this->payloadBits += other.payloadBits;
+        this->headerBits += other.headerBits;
+        this->limitBits += other.limitBits;
+    }
+
+    uint64_t Metrics::UncompressedBytes() const
+    {
+        return this->compress ? this->inputBytes : this->outputBytes;
+    }
+
+    double Metrics::AverageCodeLength() const
+    {
+        if (this->numSymbols == 0)
+            return 0;
+
+        return static_cast<double>(this->payloadBits) / this->numSymbols;
+    }
+
+    double Metrics::Throughput(double seconds) const
+    {
+        if (seconds <= 0)
+            return 0;
+
+        return this->UncompressedBytes() / (1024.0 * 1024.0) / seconds;
+    }
+
+    double Metrics::PerByte(uint64_t events) const
+    {
+        if (this->UncompressedBytes() == 0)
+            return 0;
+
+        return static_cast<double>(events) / this->UncompressedBytes();
+    }
+
+    void Metrics::PrintCounters(std::ostream&        output,
+                                const CounterValues& counters) const
+    {
+        output << " ";
+
+        for (uint8_t c = 0; c < NUM_COUNTERS; c++)
+        {
+            if (counters.Has(static_cast<Counter>(c)))
+                output << " " << COUNTER_LABELS[c] << ": " << counters.values[c];
+        }
+
+        if (counters.Has(Counter::CYCLES) and counters.Has(Counter::INSTRUCTIONS))
+            output << "  IPC: " << InstructionsPerCycle(counters);
+
+        if (counters.Has(Counter::BRANCH_MISSES))
+            output << "  branch misses/byte: "
+                   << this->PerByte(counters.Get(Counter::BRANCH_MISSES));
+
+        output << std::endl;
+    }
+
+    void Metrics::PrintText(std::ostream& output) const
+    {
+        output << std::fixed << std::setprecision(6);
+
+        for (const PhaseMetrics& measured : this->phases)
+        {
+            output << PHASE_LABELS[static_cast<uint8_t>(measured.phase)] << ": "
+                   << measured.seconds << "s" << std::endl;
+
+            if (measured.counters.available)
+                this->PrintCounters(output, measured.counters);
+        }
+
+        output << "Tempo total: " << this->totalSeconds << "s" << std::endl;
+
+        if (not this->compress)
+            return;
+
+        // Custo do limite: bytes a mais no binário em relação aos códigos ótimos
+        uint64_t limitBytes = (this->limitBits + BYTE_SIZE - 1) / BYTE_SIZE;
+
+        if (limitBytes > 0)
+            output << "Códigos limitados a " << int(this->maxCodeLength) << " bits: +"
+                   << limitBytes << " bytes no binário (+"
+                   << 100.0 * limitBytes / (this->outputBytes - limitBytes) << "%)"
+                   << std::endl;
+
+        if (this->inputBytes > this->outputBytes)
+            output << std::setprecision(2) << "Taxa de compressão: "
+                   << 100.0 * (this->inputBytes - this->outputBytes) / this->inputBytes
+                   << "%" << std::endl;
+    }
+
+    void Metrics::PrintJson(std::ostream& output) const
+    {
+        output << std::fixed << std::setprecision(6) << "{\"operation\":\""
+               << (this->compress ? "compress" : "decompress") << "\""
+               << ",\"input_bytes\":" << this->inputBytes
+               << ",\"output_bytes\":" << this->outputBytes
+               << ",\"header_bytes\":" << (this->headerBits + BYTE_SIZE - 1) / BYTE_SIZE
+               << ",\"symbols\":" << this->numSymbols
+               << ",\"average_code_length\":" << this->AverageCodeLength()
+               << ",\"limit_bytes\":" << (this->limitBits + BYTE_SIZE - 1) / BYTE_SIZE
+               << ",\"total_seconds\":" << this->totalSeconds
+               << ",\"throughput_mb_s\":" << this->Throughput(this->totalSeconds)
+               << ",\"phases\":{";
+
+        for (std::size_t i = 0; i < this->phases.size(); i++)
+        {
+            const PhaseMetrics& measured = this->phases[i];
+
+            output << (i > 0 ? "," : "") << "\""
+                   << PHASE_KEYS[static_cast<uint8_t>(measured.phase)]
+                   << "\":{\"seconds\":" << measured.seconds
+                   << ",\"throughput_mb_s\":" << this->Throughput(measured.seconds);
+
+            if (measured.counters.available)
+            {
+                output << ",\"counters\":{";
+
+                bool first = true;
+                for (uint8_t c = 0; c < NUM_COUNTERS; c++)
+                {
+                    if (not measured.counters.Has(static_cast<Counter>(c)))
+                        continue;
+
+                    output << (first ? "" : ",") << "\"" << COUNTER_KEYS[c]
+                           << "\":" << measured.counters.values[c];
+                    first = false;
+                }
+
+                if (measured.counters.Has(Counter::CYCLES) and
+                    measured.counters.Has(Counter::INSTRUCTIONS))
+                    output << ",\"ipc\":" << InstructionsPerCycle(measured.counters);
+
+                if (measured.counters.Has(Counter::BRANCH_MISSES))
+                {
+                    uint64_t misses = measured.counters.Get(Counter::BRANCH_MISSES);
+                    output << ",\"branch_misses_per_byte\":" << this->PerByte(misses);
+                }
+
+                output << "}";
+            }
+
+            output << "}";
+        }
+
+        output << "}}" << std::endl;
+    }
+} // namespace huff
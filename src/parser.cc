@@ -9,52 +9,31 @@
 
 namespace huff
 {
-    bool Parser::IsUTF8(std::ifstream& file)
+    bool Parser::CheckSignature(std::istream& file, Format& format)
     {
-        unsigned char buffer[20];
-        file.read((char*)buffer, sizeof(buffer));
-
-        // Verifica se os bytes indicam um arquivo UTF-8 válido (sem BOM)
-        int numBytes = 0;
-        for (int i = 0; i < file.gcount(); i++)
-        {
-            if ((buffer[i] & 0x80) == 0)
-                numBytes = 1; // Caractere ASCII de 1 byte
-
-            else if ((buffer[i] & 0xE0) == 0xC0)
-                numBytes = 2; // Inicia sequência de 2 bytes
-
-            else if ((buffer[i] & 0xF0) == 0xE0)
-                numBytes = 3; // Inicia sequência de 3 bytes
-
-            else if ((buffer[i] & 0xF8) == 0xF0)
-                numBytes = 4; // Inicia sequência de 4 bytes (máximo em UTF-8)
+        char buffer[SIGNATURE.size()] = {};
+        file.read(buffer, sizeof(buffer));
 
-            else
-                return false; // Byte inválido
+        // Arquivos menores que a assinatura não têm nenhum formato conhecido
+        if (file.gcount() != static_cast<std::streamsize>(SIGNATURE.size()))
+            return false;
 
-            for (int j = 1; j < numBytes; j++)
-            {
-                if (i + j >= file.gcount())
-                    return false; // Fim prematuro do arquivo
+        std::string signature(buffer, SIGNATURE.size());
 
-                if ((buffer[i + j] & 0xC0) != 0x80)
-                    return false; // Caractere mal formado
-            }
+        if (signature == SIGNATURE)
+            format = Format::LEGACY;
+        else if (signature == CANONICAL_SIGNATURE)
+            format = Format::CANONICAL;
+        else if (signature == BLOCK_SIGNATURE)
+            format = Format::BLOCK;
+        else if (signature == INTERLEAVED_SIGNATURE)
+            format = Format::INTERLEAVED;
+        else
+            return false;
 
-            i += numBytes - 1;
-        }
         return true;
     }
 
-    bool Parser::CheckSignature(std::ifstream& file)
-    {
-        char buffer[SIGNATURE.size()];
-        file.read(buffer, sizeof(buffer));
-
-        return std::string(buffer, SIGNATURE.size()) == SIGNATURE;
-    }
-
     bool Parser::CheckDecodeCompatibility(std::string filename)
     {
         std::ifstream file(filename, std::ios::binary);
@@ -73,21 +52,17 @@ namespace huff
 
     bool Parser::CheckEncodeCompatibility(std::string filename)
     {
-        std::ifstream file(filename, std::ios::binary);
+        std::error_code error;
 
-        if (not file.is_open() or std::filesystem::is_directory(filename))
+        if (not std::filesystem::exists(filename, error) or
+            std::filesystem::is_directory(filename, error))
             throw huffexcpt::CouldNotOpenFile(filename);
 
-        if (not Parser::IsUTF8(file))
-            throw huffexcpt::IsNotUTF8Encoding(filename);
-
-        file.seekg(0, std::ifstream::end);
-
-        // Verifica se o arquivo está vazio
-        if (file.tellg() == 0)
+        // Apenas o tamanho de arquivos regulares é conhecido antes da leitura
+        if (std::filesystem::is_regular_file(filename, error) and
+            std::filesystem::file_size(filename, error) == 0)
             throw huffexcpt::FileIsEmpty(filename);
 
-        file.close();
         return true;
     }
 } // namespace huff
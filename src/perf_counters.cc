@@ -0,0 +1,122 @@
+/*
+ * Filename: perf_counters.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "perf_counters.h"
+
+#ifdef HUFF_PERF_COUNTERS
+
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace huff
+{
+    // Tipo e configuração do evento de cada contador, indexados pelo contador
+    static const uint32_t COUNTER_TYPES[] = { PERF_TYPE_HARDWARE,
+                                              PERF_TYPE_HARDWARE,
+                                              PERF_TYPE_HARDWARE,
+                                              PERF_TYPE_HARDWARE,
+                                              PERF_TYPE_HW_CACHE };
+    static const uint64_t COUNTER_CONFIGS[] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+
+    PerfCounters::PerfCounters()
+        : m_opened(false)
+    {
+        this->m_fds.fill(-1);
+    }
+
+    PerfCounters::~PerfCounters()
+    {
+        for (int fd : this->m_fds)
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+    }
+
+    void PerfCounters::Open()
+    {
+        this->m_opened = true;
+
+        for (uint8_t i = 0; i < NUM_COUNTERS; i++)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+
+            attr.size   = sizeof(attr);
+            attr.type   = COUNTER_TYPES[i];
+            attr.config = COUNTER_CONFIGS[i];
+
+            // Apenas o código do próprio processo, o que também é permitido sem
+            // privilégios
+            attr.disabled       = 1;
+            attr.inherit        = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+
+            // Se houver mais contadores que registradores, o kernel os reveza e os
+            // valores são corrigidos pela fração do tempo em que foram contados
+            attr.read_format =
+                PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            this->m_fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+    }
+
+    void PerfCounters::Start()
+    {
+        if (not this->m_opened)
+            this->Open();
+
+        for (int fd : this->m_fds)
+        {
+            if (fd < 0)
+                continue;
+
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    CounterValues PerfCounters::Stop()
+    {
+        CounterValues counters;
+
+        for (uint8_t i = 0; i < NUM_COUNTERS; i++)
+        {
+            int fd = this->m_fds[i];
+
+            if (fd < 0)
+                continue;
+
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            // Valor, tempo ativo e tempo efetivamente contado
+            uint64_t data[3];
+
+            if (read(fd, data, sizeof(data)) != sizeof(data) or data[2] == 0)
+                continue;
+
+            counters.values[i] = data[1] == data[2]
+                                     ? data[0]
+                                     : uint64_t(double(data[0]) * data[1] / data[2]);
+            counters.available |= 1 << i;
+        }
+
+        return counters;
+    }
+} // namespace huff
+
+#endif // HUFF_PERF_COUNTERS
@@ -0,0 +1,544 @@
+/*
+ * Filename: utf8_validator.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ */
+
+#include "utf8_validator.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) and defined(__GNUC__)
+#define UTF8_SIMD
+#include <immintrin.h>
+#endif
+
+namespace huff
+{
+    static inline bool IsContinuation(unsigned char byte)
+    {
+        return (byte & 0xC0) == 0x80;
+    }
+
+    // Tamanho da sequência iniciada por `lead`, ou 0 se o byte não inicia sequências
+    static inline std::size_t SequenceLength(unsigned char lead)
+    {
+        if (lead < 0x80)
+            return 1;
+
+        if (lead >= 0xC2 and lead <= 0xDF)
+            return 2;
+
+        if (lead >= 0xE0 and lead <= 0xEF)
+            return 3;
+
+        if (lead >= 0xF0 and lead <= 0xF4)
+            return 4;
+
+        return 0;
+    }
+
+    // Verificação byte a byte a partir da posição `i`, que inicia uma sequência
+    static uint64_t FindInvalidScalar(const unsigned char* data,
+                                      std::size_t          size,
+                                      std::size_t          i)
+    {
+        while (i < size)
+        {
+            // Oito bytes ASCII de uma vez
+            if (i + sizeof(uint64_t) <= size)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+
+                if ((word & 0x8080808080808080) == 0)
+                {
+                    i += sizeof(word);
+                    continue;
+                }
+            }
+
+            unsigned char lead = data[i];
+
+            if (lead < 0x80)
+            {
+                i++;
+                continue;
+            }
+
+            std::size_t length = SequenceLength(lead);
+
+            if (length == 0 or i + length > size)
+                return i;
+
+            // O intervalo do segundo byte exclui as codificações não mínimas, os
+            // surrogates (U+D800 a U+DFFF) e os valores acima de U+10FFFF
+            unsigned char low  = 0x80;
+            unsigned char high = 0xBF;
+
+            if (lead == 0xE0)
+                low = 0xA0;
+            else if (lead == 0xED)
+                high = 0x9F;
+            else if (lead == 0xF0)
+                low = 0x90;
+            else if (lead == 0xF4)
+                high = 0x8F;
+
+            if (data[i + 1] < low or data[i + 1] > high)
+                return i;
+
+            for (std::size_t k = 2; k < length; k++)
+            {
+                if (not IsContinuation(data[i + k]))
+                    return i;
+            }
+
+            i += length;
+        }
+
+        return UTF8_VALID;
+    }
+
+    // Início da última sequência que começa antes da posição `i` e ainda não terminou
+    // nela (ou que começa com um byte inválido); ou a própria `i`
+    static std::size_t SequenceStart(const unsigned char* data, std::size_t i)
+    {
+        for (std::size_t j = i; j > 0 and i - j < UTF8_MAX_CONTINUATION;)
+        {
+            j--;
+
+            if (IsContinuation(data[j]))
+                continue;
+
+            std::size_t length = SequenceLength(data[j]);
+            return length == 0 or length > i - j ? j : i;
+        }
+
+        return i;
+    }
+
+#ifdef UTF8_SIMD
+    // Cada par de bytes consecutivos é classificado pelos nibbles do primeiro byte e
+    // pelo nibble alto do segundo. Cada tabela marca os erros possíveis para o
+    // nibble, e um erro ocorre quando os três nibbles o marcam
+    constexpr uint8_t TOO_SHORT  = 1 << 0; // Início sem continuação
+    constexpr uint8_t TOO_LONG   = 1 << 1; // ASCII seguido de continuação
+    constexpr uint8_t OVERLONG_3 = 1 << 2; // 11100000 100_____
+    constexpr uint8_t TOO_LARGE  = 1 << 3; // Acima de U+10FFFF
+    constexpr uint8_t SURROGATE  = 1 << 4; // 11101101 101_____
+    constexpr uint8_t OVERLONG_2 = 1 << 5; // 1100000_ 10______
+    constexpr uint8_t TOO_LARGE_1000 = 1 << 6; // Acima de U+10FFFF, com 1000____
+    constexpr uint8_t OVERLONG_4     = 1 << 6; // 11110000 1000____
+    constexpr uint8_t TWO_CONTS      = 1 << 7; // Duas continuações seguidas
+    constexpr uint8_t CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+    alignas(16) static const uint8_t BYTE_1_HIGH[16] = {
+        TOO_LONG,
+        TOO_LONG,
+        TOO_LONG,
+        TOO_LONG,
+        TOO_LONG,
+        TOO_LONG,
+        TOO_LONG,
+        TOO_LONG,
+        TWO_CONTS,
+        TWO_CONTS,
+        TWO_CONTS,
+        TWO_CONTS,
+        TOO_SHORT | OVERLONG_2,
+        TOO_SHORT,
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+    };
+
+    alignas(16) static const uint8_t BYTE_1_LOW[16] = {
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        CARRY | OVERLONG_2,
+        CARRY,
+        CARRY,
+        CARRY | TOO_LARGE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000
+    };
+
+    alignas(16) static const uint8_t BYTE_2_HIGH[16] = {
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT,
+        TOO_SHORT
+    };
+
+    // Maior valor que o byte pode ter sem iniciar uma sequência que termina após o
+    // fim do vetor (apenas os três últimos bytes têm limite)
+    alignas(16) static const uint8_t INCOMPLETE_MAX[16] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+    };
+
+    /**
+     * @brief Verifica os vetores completos de 32 bytes
+     * @return Início do primeiro vetor com erro, ou do restante que não forma um
+     *vetor completo
+     **/
+    __attribute__((target("avx2"))) static std::size_t
+    CheckVectorsAVX2(const unsigned char* data, std::size_t size)
+    {
+        // As tabelas são repetidas nas duas metades do registrador, pois as
+        // consultas (shuffle) não cruzam as metades
+        const __m256i byte1High = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH)));
+        const __m256i byte1Low = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW)));
+        const __m256i byte2High = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH)));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+        // Apenas a segunda metade do registrador contém os últimos bytes
+        const __m256i incompleteMax = _mm256_inserti128_si256(
+            _mm256_set1_epi8(char(0xFF)),
+            _mm_load_si128(reinterpret_cast<const __m128i*>(INCOMPLETE_MAX)),
+            1);
+
+        __m256i previous   = _mm256_setzero_si256();
+        __m256i incomplete = _mm256_setzero_si256();
+
+        std::size_t i = 0;
+        for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i))
+        {
+            __m256i input =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+
+            // Vetor ASCII: só é preciso que o anterior não termine no meio de uma
+            // sequência
+            if (_mm256_movemask_epi8(input) == 0)
+            {
+                if (not _mm256_testz_si256(incomplete, incomplete))
+                    break;
+
+                previous = input;
+                continue;
+            }
+
+            // Bytes anteriores a cada posição, vindos também do vetor anterior
+            __m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+            __m256i prev1   = _mm256_alignr_epi8(input, carried, 15);
+            __m256i prev2   = _mm256_alignr_epi8(input, carried, 14);
+            __m256i prev3   = _mm256_alignr_epi8(input, carried, 13);
+
+            __m256i special = _mm256_and_si256(
+                _mm256_and_si256(
+                    _mm256_shuffle_epi8(
+                        byte1High,
+                        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                    _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble))),
+                _mm256_shuffle_epi8(
+                    byte2High,
+                    _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+            // O terceiro e o quarto bytes das sequências longas devem ser
+            // continuações, o que cancela a marca TWO_CONTS
+            __m256i must23 = _mm256_or_si256(
+                _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80))),
+                _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80))));
+            __m256i error = _mm256_xor_si256(
+                _mm256_and_si256(must23, _mm256_set1_epi8(char(0x80))), special);
+
+            if (not _mm256_testz_si256(error, error))
+                break;
+
+            incomplete = _mm256_subs_epu8(input, incompleteMax);
+            previous   = input;
+        }
+
+        return i;
+    }
+
+    /**
+     * @brief Verifica os vetores completos de 16 bytes
+     * @return Início do primeiro vetor com erro, ou do restante que não forma um
+     *vetor completo
+     **/
+    __attribute__((target("sse4.1"))) static std::size_t
+    CheckVectorsSSE(const unsigned char* data, std::size_t size)
+    {
+        const __m128i byte1High =
+            _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH));
+        const __m128i byte1Low =
+            _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW));
+        const __m128i byte2High =
+            _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH));
+        const __m128i incompleteMax =
+            _mm_load_si128(reinterpret_cast<const __m128i*>(INCOMPLETE_MAX));
+        const __m128i nibble        = _mm_set1_epi8(0x0F);
+
+        __m128i previous   = _mm_setzero_si128();
+        __m128i incomplete = _mm_setzero_si128();
+
+        std::size_t i = 0;
+        for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i))
+        {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+            if (_mm_movemask_epi8(input) == 0)
+            {
+                if (not _mm_testz_si128(incomplete, incomplete))
+                    break;
+
+                previous = input;
+                continue;
+            }
+
+            __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+            __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+            __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+
+            __m128i special = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(byte1High,
+                                     _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                    _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble))),
+                _mm_shuffle_epi8(byte2High,
+                                 _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+            __m128i must23 =
+                _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(char(0xE0 - 0x80))),
+                             _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80))));
+            __m128i error = _mm_xor_si128(
+                _mm_and_si128(must23, _mm_set1_epi8(char(0x80))), special);
+
+            if (not _mm_testz_si128(error, error))
+                break;
+
+            incomplete = _mm_subs_epu8(input, incompleteMax);
+            previous   = input;
+        }
+
+        return i;
+    }
+
+    using CheckVectorsFunction = std::size_t (*)(const unsigned char*, std::size_t);
+
+    // Escolhe a maior extensão vetorial suportada pelo processador
+    static CheckVectorsFunction SelectCheckVectors()
+    {
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return CheckVectorsAVX2;
+
+        if (__builtin_cpu_supports("sse4.1"))
+            return CheckVectorsSSE;
+
+        return nullptr;
+    }
+#endif // UTF8_SIMD
+
+    uint64_t FindInvalidUTF8(const unsigned char* data, std::size_t size)
+    {
+        std::size_t i = 0;
+
+#ifdef UTF8_SIMD
+        static const CheckVectorsFunction checkVectors = SelectCheckVectors();
+
+        if (checkVectors)
+            i = checkVectors(data, size);
+#endif // UTF8_SIMD
+
+        // Os bytes que não formam um vetor completo, ou o vetor em que um erro foi
+        // detectado, são verificados byte a byte a partir do início da sequência que
+        // os contém, que pode ter começado no vetor anterior
+        return FindInvalidScalar(data, size, SequenceStart(data, i));
+    }
+
+    UTF8Validator::UTF8Validator()
+        : m_size(0),
+          m_error(UTF8_VALID),
+          m_headSize(0),
+          m_tailSize(0)
+    { }
+
+    void UTF8Validator::SetError(uint64_t offset)
+    {
+        this->m_error = std::min(this->m_error, offset);
+    }
+
+    void UTF8Validator::Scan(const unsigned char* data, std::size_t size)
+    {
+        this->m_size = size;
+
+        // Continuações no início, que pertencem a uma sequência da parte anterior
+        while (this->m_headSize < std::min<std::size_t>(size, UTF8_MAX_CONTINUATION) and
+               IsContinuation(data[this->m_headSize]))
+        {
+            this->m_head[this->m_headSize] = data[this->m_headSize];
+            this->m_headSize++;
+        }
+
+        // A sequência incompleta do final começa em um dos três últimos bytes
+        std::size_t j = size;
+        while (j > this->m_headSize and size - j < UTF8_MAX_CONTINUATION)
+        {
+            j--;
+
+            if (IsContinuation(data[j]))
+                continue;
+
+            if (SequenceLength(data[j]) > size - j)
+            {
+                this->m_tailSize = size - j;
+                std::memcpy(this->m_tail, data + j, this->m_tailSize);
+            }
+
+            break;
+        }
+
+        uint64_t error = FindInvalidUTF8(data + this->m_headSize,
+                                         size - this->m_headSize - this->m_tailSize);
+
+        if (error != UTF8_VALID)
+            this->SetError(this->m_headSize + error);
+    }
+
+    void UTF8Validator::Update(const unsigned char* data, std::size_t size)
+    {
+        UTF8Validator part;
+        part.Scan(data, size);
+
+        this->Append(part);
+    }
+
+    void UTF8Validator::Append(const UTF8Validator& next)
+    {
+        if (next.m_size == 0)
+            return;
+
+        if (this->m_size == 0)
+        {
+            *this = next;
+            return;
+        }
+
+        // Início da parte seguinte
+        uint64_t offset = this->m_size;
+        this->m_size += next.m_size;
+
+        if (not this->IsValid())
+            return;
+
+        // Se as partes validadas até aqui contêm apenas bytes de continuação, os da
+        // parte seguinte se juntam a eles
+        if (this->m_headSize == offset)
+        {
+            for (uint8_t i = 0; i < next.m_headSize; i++)
+            {
+                if (this->m_headSize == UTF8_MAX_CONTINUATION)
+                {
+                    this->SetError(offset + i);
+                    return;
+                }
+
+                this->m_head[this->m_headSize++] = next.m_head[i];
+            }
+
+            if (not next.IsValid())
+                this->SetError(offset + next.m_error);
+
+            this->m_tailSize = next.m_tailSize;
+            std::memcpy(this->m_tail, next.m_tail, next.m_tailSize);
+            return;
+        }
+
+        // Bytes de continuação que faltam para completar a sequência do final
+        uint8_t missing =
+            this->m_tailSize > 0 ? SequenceLength(this->m_tail[0]) - this->m_tailSize
+                                 : 0;
+
+        if (next.m_headSize < missing)
+        {
+            // A parte seguinte ainda não completa a sequência
+            if (next.m_headSize == next.m_size)
+            {
+                std::memcpy(this->m_tail + this->m_tailSize,
+                            next.m_head,
+                            next.m_headSize);
+                this->m_tailSize += next.m_headSize;
+            }
+            else
+                this->SetError(offset - this->m_tailSize);
+
+            return;
+        }
+
+        if (missing > 0)
+        {
+            unsigned char sequence[UTF8_MAX_CONTINUATION + 1];
+            std::memcpy(sequence, this->m_tail, this->m_tailSize);
+            std::memcpy(sequence + this->m_tailSize, next.m_head, missing);
+
+            if (FindInvalidUTF8(sequence, this->m_tailSize + missing) != UTF8_VALID)
+            {
+                this->SetError(offset - this->m_tailSize);
+                return;
+            }
+        }
+
+        // Continuações além das que completam a sequência não pertencem a nenhuma
+        if (next.m_headSize > missing)
+        {
+            this->SetError(offset + missing);
+            return;
+        }
+
+        if (not next.IsValid())
+            this->SetError(offset + next.m_error);
+
+        this->m_tailSize = next.m_tailSize;
+        std::memcpy(this->m_tail, next.m_tail, next.m_tailSize);
+    }
+
+    bool UTF8Validator::Finish()
+    {
+        // Continuações no início do arquivo e uma sequência interrompida no final. Após
+        // um erro, a sequência do final não é mais atualizada
+        if (this->m_tailSize > 0 and this->IsValid())
+            this->SetError(this->m_size - this->m_tailSize);
+
+        if (this->m_headSize > 0)
+            this->SetError(0);
+
+        return this->IsValid();
+    }
+
+    bool UTF8Validator::IsValid() const
+    {
+        return this->m_error == UTF8_VALID;
+    }
+
+    uint64_t UTF8Validator::GetErrorOffset() const
+    {
+        return this->m_error;
+    }
+} // namespace huff
@@ -0,0 +1,341 @@
+/*
+ * Filename: bench.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Microbenchmark de cada etapa do codec, executado dentro do processo sobre arquivos
+ * carregados em memória: cálculo das frequências dos bytes e dos code points,
+ * validação UTF-8, construção da trie e dos códigos, escrita dos códigos, escrita e
+ * leitura da tabela de comprimentos e decodificação, com um fluxo ou com os fluxos
+ * intercalados. Cada etapa é executada algumas vezes para aquecimento e depois
+ * medida em várias repetições, das quais são exibidos a mediana e os percentis.
+ *
+ * Uso: bench [arquivo ou diretório] [repetições] [aquecimento]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bit_reader.h"
+#include "bit_writer.h"
+#include "code_points.h"
+#include "histogram.h"
+#include "huffman_code.h"
+#include "huffman_compress.h"
+#include "huffman_decoder.h"
+#include "utf8_validator.h"
+
+namespace huff
+{
+    // Acesso às etapas internas do compressor
+    class Benchmark
+    {
+        public:
+            static void BuildTrie(Compress&                       compress,
+                                  const std::vector<std::size_t>& frequencies)
+            {
+                compress.BuildTrie(frequencies);
+            }
+
+            static void BuildCodeLengths(Compress&                       compress,
+                                         const std::vector<std::size_t>& frequencies)
+            {
+                compress.BuildCodeLengths(frequencies);
+            }
+
+            static void BuildCode(Compress& compress)
+            {
+                compress.BuildCode();
+            }
+
+            static const std::vector<Code>& GetCodeTable(const Compress& compress)
+            {
+                return compress.m_codeTable;
+            }
+    };
+} // namespace huff
+
+// Tempos das repetições de uma etapa, em segundos, em ordem crescente
+struct Samples
+{
+        std::vector<double> seconds;
+
+        // Percentil pelo método do posto mais próximo
+        double Percentile(double p) const
+        {
+            std::size_t rank = std::ceil(p / 100.0 * this->seconds.size());
+            return this->seconds[std::max<std::size_t>(rank, 1) - 1];
+        }
+};
+
+Samples Measure(int warmup, int repetitions, std::function<void()> function)
+{
+    Samples samples;
+
+    for (int r = 0; r < warmup; r++)
+        function();
+
+    for (int r = 0; r < repetitions; r++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        function();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        samples.seconds.push_back(std::chrono::duration<double>(end - start).count());
+    }
+
+    std::sort(samples.seconds.begin(), samples.seconds.end());
+    return samples;
+}
+
+// A taxa só é exibida para as etapas que percorrem o arquivo (bytes > 0)
+void Report(const std::string& name, const Samples& samples, std::size_t bytes = 0)
+{
+    double median = samples.Percentile(50);
+
+    std::cout << "  " << std::left << std::setw(18) << name << std::right
+              << " mediana " << std::setw(10) << median * 1e6 << " us"
+              << "  p90 " << std::setw(10) << samples.Percentile(90) * 1e6 << " us"
+              << "  p99 " << std::setw(10) << samples.Percentile(99) * 1e6 << " us";
+
+    if (bytes > 0)
+        std::cout << "  " << std::setw(9) << bytes / (1024.0 * 1024.0) / median
+                  << " MB/s";
+
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::filesystem::path path        = argc > 1 ? argv[1] : "test/inputs";
+    int                   repetitions = argc > 2 ? std::atoi(argv[2]) : 50;
+    int                   warmup      = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    if (repetitions <= 0 or warmup < 0)
+    {
+        std::cerr << "ERRO: Quantidade de repetições inválida" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::filesystem::path> files;
+
+    if (std::filesystem::is_directory(path))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(path))
+        {
+            if (entry.is_regular_file())
+                files.push_back(entry.path());
+        }
+    }
+    else
+        files.push_back(path);
+
+    std::sort(files.begin(), files.end());
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (const std::filesystem::path& filename : files)
+    {
+        std::ifstream file(filename, std::ios::binary);
+
+        if (not file.is_open())
+        {
+            std::cerr << "ERRO: Falha ao abrir o arquivo '" << filename.string() << "'"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::vector<unsigned char> input((std::istreambuf_iterator<char>(file)),
+                                         std::istreambuf_iterator<char>());
+
+        if (input.empty())
+            continue;
+
+        std::size_t checksum = 0;
+
+        // Estado compartilhado pelas etapas: cada etapa parte do resultado da
+        // anterior, calculado uma vez fora da medição
+        huff::Compress           compress;
+        std::vector<std::size_t> frequencies;
+        huff::Histogram          histogram;
+
+        histogram.Count(input.data(), input.size());
+        histogram.Merge(frequencies);
+
+        huff::Benchmark::BuildTrie(compress, frequencies);
+        huff::Benchmark::BuildCode(compress);
+
+        std::vector<huff::Code> codes = huff::Benchmark::GetCodeTable(compress);
+        huff::AssignCanonicalCodes(codes);
+
+        huff::BitWriter table;
+        huff::WriteCodeLengths(table, codes);
+        table.AlignToByte();
+
+        huff::BitWriter payload;
+        for (unsigned char byte : input)
+            payload.Write(codes[byte].bits, codes[byte].length);
+
+        payload.AlignToByte(true);
+
+        // Os mesmos códigos divididos entre os fluxos do formato intercalado
+        huff::BitWriter streams[huff::INTERLEAVED_STREAMS];
+        for (std::size_t i = 0; i < input.size(); i++)
+            streams[i % huff::INTERLEAVED_STREAMS].Write(codes[input[i]].bits,
+                                                         codes[input[i]].length);
+
+        for (huff::BitWriter& stream : streams)
+            stream.AlignToByte(true);
+
+        huff::HuffmanDecoder decoder;
+        decoder.Build(huff::ListCodes(codes));
+
+        std::cout << "Arquivo: " << filename.string() << " (" << input.size()
+                  << " bytes, " << repetitions << " repetições, " << warmup
+                  << " de aquecimento)" << std::endl;
+
+        Report("Frequencies",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::Histogram          histogram;
+                           std::vector<std::size_t> frequencies;
+
+                           histogram.Count(input.data(), input.size());
+                           histogram.Merge(frequencies);
+
+                           checksum += frequencies[input.front()];
+                       }),
+               input.size());
+
+        Report("UTF8Validator",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::UTF8Validator validator;
+
+                           validator.Update(input.data(), input.size());
+                           checksum += validator.Finish();
+                       }),
+               input.size());
+
+        Report("CodePointHistogram",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::CodePointHistogram histogram;
+                           std::vector<uint32_t>    symbols;
+                           std::vector<std::size_t> frequencies;
+
+                           histogram.Count(input.data(), input.size());
+                           histogram.List(symbols, frequencies);
+
+                           checksum += symbols.size();
+                       }),
+               input.size());
+
+        Report("BuildTrie",
+               Measure(warmup,
+                       repetitions,
+                       [&]() { huff::Benchmark::BuildTrie(compress, frequencies); }));
+
+        Report("BuildCode",
+               Measure(warmup,
+                       repetitions,
+                       [&]() { huff::Benchmark::BuildCode(compress); }));
+
+        Report("BuildCodeLengths",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       { huff::Benchmark::BuildCodeLengths(compress, frequencies); }));
+
+        Report("BitWriter",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::BitWriter writer;
+
+                           for (unsigned char byte : input)
+                               writer.Write(codes[byte].bits, codes[byte].length);
+
+                           writer.AlignToByte(true);
+                           checksum += writer.GetSize();
+                       }),
+               input.size());
+
+        Report("WriteCodeLengths",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::BitWriter writer;
+                           huff::WriteCodeLengths(writer, codes);
+                           writer.AlignToByte();
+
+                           checksum += writer.GetSize();
+                       }));
+
+        Report("ReadCodeLengths",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::BitReader         reader(table.GetData(),
+                                                  table.GetSize());
+                           std::vector<huff::Code> parsed;
+
+                           checksum += huff::ReadCodeLengths(reader, parsed);
+                       }));
+
+        Report("Decode",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::BitReader reader(payload.GetData(), payload.GetSize());
+                           std::vector<unsigned char> output(input.size());
+
+                           decoder.Decode(reader, input.size(), output.data());
+                           checksum += output.back();
+                       }),
+               input.size());
+
+        Report("InterleavedDecode",
+               Measure(warmup,
+                       repetitions,
+                       [&]()
+                       {
+                           huff::InterleavedReaders   readers;
+                           std::vector<unsigned char> output(input.size());
+
+                           for (uint8_t s = 0; s < huff::INTERLEAVED_STREAMS; s++)
+                               readers[s] = huff::BitReader(streams[s].GetData(),
+                                                            streams[s].GetSize());
+
+                           decoder.Decode(readers, input.size(), output.data());
+                           checksum += output.back();
+                       }),
+               input.size());
+
+        // Impede que o compilador descarte os resultados
+        if (checksum == 0)
+            std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
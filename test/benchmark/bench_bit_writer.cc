@@ -0,0 +1,158 @@
+/*
+ * Filename: bench_bit_writer.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Microbenchmark da escrita do payload: compara o empacotamento antigo (string de
+ * '0'/'1' reempacotada em bytes) com o BitWriter. Os códigos usados têm os
+ * comprimentos de Shannon calculados a partir das frequências do próprio arquivo.
+ *
+ * Uso: bench_bit_writer [arquivo] [repetições]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "bit_writer.h"
+#include "huffman_compress.h"
+
+// Stream que descarta tudo o que é escrito, para medir apenas o empacotamento
+class NullBuffer : public std::streambuf
+{
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize n) override
+        {
+            return n;
+        }
+};
+
+// Cópia do antigo Compress::WriteBuffer
+void LegacyWriteBuffer(std::ostream& file, std::string& buffer)
+{
+    std::size_t    numBytes = buffer.size() / BYTE_SIZE;
+    unsigned char* data     = new unsigned char[numBytes];
+
+    for (std::size_t i = 0; i < numBytes; ++i)
+    {
+        unsigned char byte = 0;
+
+        for (std::size_t j = 0; j < BYTE_SIZE; ++j)
+        {
+            if (buffer[i * BYTE_SIZE + j] == '1')
+                byte |= (1 << (BYTE_SIZE - 1 - j));
+        }
+        data[i] = byte;
+    }
+
+    file.write((char*)data, numBytes);
+    buffer = buffer.substr(numBytes * BYTE_SIZE);
+
+    delete[] data;
+}
+
+double Throughput(std::size_t bytes, std::chrono::duration<double> elapsed)
+{
+    return bytes / (1024.0 * 1024.0) / elapsed.count();
+}
+
+int main(int argc, char* argv[])
+{
+    std::string filename    = argc > 1 ? argv[1] : "test/inputs/geordian-dict-3bytes.txt";
+    int         repetitions = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::ifstream file(filename, std::ios::binary);
+
+    if (not file.is_open())
+    {
+        std::cerr << "ERRO: Falha ao abrir o arquivo '" << filename << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<unsigned char> input((std::istreambuf_iterator<char>(file)),
+                                     std::istreambuf_iterator<char>());
+
+    // Comprimentos de Shannon: ceil(-log2(p)), limitados a 32 bits
+    std::vector<std::size_t> frequencies(256, 0);
+    for (unsigned char byte : input)
+        frequencies[byte]++;
+
+    std::vector<huff::Code>  codes(256);
+    std::vector<std::string> legacyCodes(256);
+    for (std::size_t i = 0; i < codes.size(); i++)
+    {
+        if (frequencies[i] == 0)
+            continue;
+
+        double p = frequencies[i] / static_cast<double>(input.size());
+        codes[i].length =
+            std::clamp(static_cast<int>(std::ceil(-std::log2(p))), 1, 32);
+        codes[i].bits = i & ((uint64_t(1) << codes[i].length) - 1);
+
+        for (int j = codes[i].length - 1; j >= 0; j--)
+            legacyCodes[i] += (codes[i].bits >> j) & 1 ? '1' : '0';
+    }
+
+    NullBuffer   nullBuffer;
+    std::ostream output(&nullBuffer);
+
+    std::chrono::duration<double> legacyBest(1e9);
+    std::chrono::duration<double> writerBest(1e9);
+
+    for (int r = 0; r < repetitions; r++)
+    {
+        auto        start = std::chrono::high_resolution_clock::now();
+        std::string bufferWrite;
+
+        for (unsigned char byte : input)
+        {
+            bufferWrite += legacyCodes[byte];
+
+            if (bufferWrite.size() >= BUFFER_MAX_SIZE)
+                LegacyWriteBuffer(output, bufferWrite);
+        }
+
+        while (bufferWrite.size() % BYTE_SIZE != 0)
+            bufferWrite += "1";
+
+        LegacyWriteBuffer(output, bufferWrite);
+
+        legacyBest = std::min<std::chrono::duration<double>>(
+            legacyBest, std::chrono::high_resolution_clock::now() - start);
+
+        start = std::chrono::high_resolution_clock::now();
+        huff::BitWriter writer(output);
+
+        for (unsigned char byte : input)
+            writer.Write(codes[byte].bits, codes[byte].length);
+
+        writer.AlignToByte(true);
+        writer.Flush();
+
+        writerBest = std::min<std::chrono::duration<double>>(
+            writerBest, std::chrono::high_resolution_clock::now() - start);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Arquivo: " << filename << " (" << input.size() << " bytes)"
+              << std::endl;
+    std::cout << "String de bits (antigo): " << Throughput(input.size(), legacyBest)
+              << " MB/s" << std::endl;
+    std::cout << "BitWriter: " << Throughput(input.size(), writerBest) << " MB/s"
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
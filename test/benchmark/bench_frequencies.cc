@@ -0,0 +1,136 @@
+/*
+ * Filename: bench_frequencies.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Microbenchmark do cálculo das frequências: compara a contagem antiga (cada byte
+ * convertido em uma string de bits e contado em um rbtree::Map), um único vetor
+ * indexado pelo byte e o Histogram com sub-histogramas intercalados.
+ *
+ * Uso: bench_frequencies [arquivo ou diretório] [repetições]
+ */
+
+#include <bitset>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "histogram.h"
+#include "huffman_compress.h"
+#include "map.h"
+
+double Throughput(std::size_t bytes, std::chrono::duration<double> elapsed)
+{
+    return bytes / (1024.0 * 1024.0) / elapsed.count();
+}
+
+// Melhor tempo entre as repetições
+std::chrono::duration<double> Measure(int repetitions, std::function<void()> function)
+{
+    std::chrono::duration<double> best(1e9);
+
+    for (int r = 0; r < repetitions; r++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        function();
+        best = std::min<std::chrono::duration<double>>(
+            best, std::chrono::high_resolution_clock::now() - start);
+    }
+
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    std::filesystem::path path        = argc > 1 ? argv[1] : "test/inputs";
+    int                   repetitions = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::vector<std::filesystem::path> files;
+
+    if (std::filesystem::is_directory(path))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(path))
+        {
+            if (entry.is_regular_file())
+                files.push_back(entry.path());
+        }
+    }
+    else
+        files.push_back(path);
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (const std::filesystem::path& filename : files)
+    {
+        std::ifstream file(filename, std::ios::binary);
+
+        if (not file.is_open())
+        {
+            std::cerr << "ERRO: Falha ao abrir o arquivo '" << filename.string() << "'"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::vector<unsigned char> input((std::istreambuf_iterator<char>(file)),
+                                         std::istreambuf_iterator<char>());
+
+        std::size_t checksum = 0;
+
+        auto mapTime = Measure(repetitions,
+                               [&]()
+                               {
+                                   rbtree::Map<std::string, std::size_t> map;
+
+                                   for (unsigned char byte : input)
+                                       map[std::bitset<BYTE_SIZE>(byte).to_string()]++;
+
+                                   checksum += map.Size();
+                               });
+
+        auto arrayTime = Measure(repetitions,
+                                 [&]()
+                                 {
+                                     std::vector<std::size_t> frequencies(ALPHABET_SIZE);
+
+                                     for (unsigned char byte : input)
+                                         frequencies[byte]++;
+
+                                     checksum += frequencies[input.front()];
+                                 });
+
+        auto histogramTime = Measure(repetitions,
+                                     [&]()
+                                     {
+                                         huff::Histogram          histogram;
+                                         std::vector<std::size_t> frequencies;
+
+                                         histogram.Count(input.data(), input.size());
+                                         histogram.Merge(frequencies);
+
+                                         checksum += frequencies[input.front()];
+                                     });
+
+        std::cout << "Arquivo: " << filename.string() << " (" << input.size()
+                  << " bytes)" << std::endl;
+        std::cout << "  rbtree::Map (antigo): " << Throughput(input.size(), mapTime)
+                  << " MB/s" << std::endl;
+        std::cout << "  Vetor único: " << Throughput(input.size(), arrayTime) << " MB/s"
+                  << std::endl;
+        std::cout << "  Histogram (" << int(huff::HISTOGRAM_LANES)
+                  << " sub-histogramas): " << Throughput(input.size(), histogramTime)
+                  << " MB/s" << std::endl;
+
+        // Impede que o compilador descarte as contagens
+        if (checksum == 0)
+            std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
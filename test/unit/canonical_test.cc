@@ -0,0 +1,161 @@
+/*
+ * Filename: canonical_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Casos extremos do formato canônico: alfabetos de um e de dois símbolos, em que
+ * todos os códigos têm um bit, e o alfabeto com todos os bytes
+ */
+
+#include <algorithm>
+#include <random>
+
+#include "codec_files.h"
+#include "doctest.h"
+
+namespace
+{
+    using codec_files::Bytes;
+
+    // Comprime no formato canônico, confere que o arquivo descomprimido com 1 e 4
+    // threads é o original e retorna os comprimentos gravados na tabela
+    std::vector<huff::Code> CheckCanonical(const std::string& name, const Bytes& data)
+    {
+        huff::Options options;
+        options.format = huff::Format::CANONICAL;
+        options.binary = true;
+
+        Bytes binary = codec_files::Encode(name, data, options);
+
+        std::size_t offset =
+            CANONICAL_SIGNATURE.size() + HEADER_RESERVED_BYTES_AT_START;
+        REQUIRE(binary.size() > offset);
+        CHECK(std::equal(CANONICAL_SIGNATURE.begin(),
+                         CANONICAL_SIGNATURE.end(),
+                         binary.begin()));
+
+        for (unsigned numThreads : { 1, 4 })
+        {
+            options.numThreads = numThreads;
+
+            CAPTURE(numThreads);
+            CHECK(codec_files::Decode(name, binary, options) == data);
+        }
+
+        std::vector<huff::Code> codes;
+        huff::BitReader         reader(binary.data() + offset, binary.size() - offset);
+
+        REQUIRE(huff::ReadCodeLengths(reader, codes));
+        return codes;
+    }
+
+    // Tamanhos que terminam o payload em várias posições do último byte
+    const std::vector<std::size_t> SIZES = { 1, 2, 7, 8, 9, 15, 16, 17, 100000 };
+} // namespace
+
+TEST_CASE("Formato canônico com um único símbolo")
+{
+    // O vizinho acrescentado (símbolo ^ 1) nunca ocorre, mas recebe o outro código
+    // de um bit
+    for (unsigned char symbol : { 0x00, 0x01, int('a'), 0x80, 0xFE, 0xFF })
+    {
+        for (std::size_t size : SIZES)
+        {
+            CAPTURE(int(symbol));
+            CAPTURE(size);
+
+            std::vector<huff::Code> codes =
+                CheckCanonical("canonical_single", Bytes(size, symbol));
+
+            for (std::size_t s = 0; s < ALPHABET_SIZE; s++)
+            {
+                CAPTURE(s);
+                CHECK(codes[s].length == (s == symbol or s == (symbol ^ 1u) ? 1 : 0));
+            }
+        }
+    }
+}
+
+TEST_CASE("Formato canônico com dois símbolos")
+{
+    std::mt19937 random(1);
+
+    struct Pair
+    {
+            unsigned char first;
+            unsigned char second;
+    };
+
+    // Vizinhos, distantes e nos extremos do alfabeto
+    for (Pair pair : { Pair { 'a', 'b' }, Pair { '0', 'z' }, Pair { 0x00, 0xFF } })
+    {
+        for (std::size_t size : SIZES)
+        {
+            if (size < 2)
+                continue;
+
+            // O segundo símbolo aparece uma vez ou em cerca de metade das posições
+            for (bool rare : { true, false })
+            {
+                Bytes data(size, pair.first);
+
+                if (rare)
+                    data[random() % size] = pair.second;
+                else
+                {
+                    for (unsigned char& byte : data)
+                        byte = random() % 2 ? pair.first : pair.second;
+
+                    data[0] = pair.second;
+                    data[1] = pair.first;
+                }
+
+                CAPTURE(int(pair.first));
+                CAPTURE(int(pair.second));
+                CAPTURE(size);
+                CAPTURE(rare);
+
+                std::vector<huff::Code> codes = CheckCanonical("canonical_pair", data);
+
+                for (std::size_t s = 0; s < ALPHABET_SIZE; s++)
+                {
+                    CAPTURE(s);
+                    CHECK(codes[s].length ==
+                          (s == pair.first or s == pair.second ? 1 : 0));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Formato canônico com todos os bytes")
+{
+    std::mt19937 random(2);
+
+    // Cada byte uma vez: todos os códigos têm 8 bits
+    Bytes flat(ALPHABET_SIZE);
+    for (std::size_t byte = 0; byte < ALPHABET_SIZE; byte++)
+        flat[byte] = byte;
+
+    std::shuffle(flat.begin(), flat.end(), random);
+
+    for (const huff::Code& code : CheckCanonical("canonical_all_bytes", flat))
+        CHECK(code.length == BYTE_SIZE);
+
+    // Bytes aleatórios e bytes com frequências desiguais, todos presentes
+    Bytes uniform(1000000);
+    for (unsigned char& byte : uniform)
+        byte = random();
+
+    Bytes skewed = flat;
+    for (std::size_t i = 0; i < 200000; i++)
+        skewed.push_back(std::min<unsigned>(random() % 64, random() % 256));
+
+    for (const Bytes& data : { uniform, skewed })
+    {
+        std::vector<huff::Code> codes = CheckCanonical("canonical_all_bytes", data);
+
+        for (const huff::Code& code : codes)
+            CHECK(code.length > 0);
+    }
+}
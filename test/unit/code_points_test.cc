@@ -0,0 +1,224 @@
+/*
+ * Filename: code_points_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Os blocos de texto com caracteres fora do ASCII podem ser comprimidos com o
+ * alfabeto de code points. A descompressão deve restaurar o arquivo em todos os
+ * casos, inclusive quando uma sequência UTF-8 é dividida entre dois blocos
+ */
+
+#include <cmath>
+#include <random>
+
+#include "codec_files.h"
+#include "doctest.h"
+#include "huffman_compress_excpt.h"
+
+namespace
+{
+    using codec_files::Bytes;
+
+    // Codificação UTF-8 de um code point válido
+    void AppendCodePoint(Bytes& data, uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+            data.push_back(codePoint);
+        else if (codePoint < 0x800)
+        {
+            data.push_back(0xC0 | codePoint >> 6);
+            data.push_back(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            data.push_back(0xE0 | codePoint >> 12);
+            data.push_back(0x80 | (codePoint >> 6 & 0x3F));
+            data.push_back(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            data.push_back(0xF0 | codePoint >> 18);
+            data.push_back(0x80 | (codePoint >> 12 & 0x3F));
+            data.push_back(0x80 | (codePoint >> 6 & 0x3F));
+            data.push_back(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    // Texto com `size` bytes ou pouco mais, formado pelos `count` code points a
+    // partir de `first`, com frequências decrescentes
+    Bytes ScriptText(uint32_t first, uint32_t count, std::size_t size, unsigned seed)
+    {
+        std::vector<double> weights;
+
+        for (uint32_t i = 0; i < count; i++)
+            weights.push_back(std::pow(0.95, i));
+
+        std::mt19937                    random(seed);
+        std::discrete_distribution<int> symbol(weights.begin(), weights.end());
+
+        Bytes data;
+
+        while (data.size() < size)
+            AppendCodePoint(data, first + symbol(random));
+
+        return data;
+    }
+
+    // Indica, para cada bloco do binário, se o alfabeto de code points foi usado
+    std::vector<bool> CodePointBlocks(const Bytes& binary)
+    {
+        auto field = [&binary](std::size_t offset)
+        {
+            uint32_t value = 0;
+            for (std::size_t i = 0; i < BLOCK_FIELD_SIZE_IN_BYTES; i++)
+                value = value << BYTE_SIZE | binary[offset + i];
+
+            return value;
+        };
+
+        std::vector<bool> blocks;
+        std::size_t       offset = BLOCK_SIGNATURE.size() + BLOCK_FIELD_SIZE_IN_BYTES;
+
+        while (field(offset) > 0)
+        {
+            std::size_t table = offset + 2 * BLOCK_FIELD_SIZE_IN_BYTES;
+            blocks.push_back(binary[table] & huff::CODE_POINT_TABLE_FLAG);
+
+            offset = table + field(offset + BLOCK_FIELD_SIZE_IN_BYTES);
+        }
+
+        return blocks;
+    }
+
+    // O arquivo descomprimido com 1 e 4 threads deve ser o original
+    void CheckDecode(const std::string&   name,
+                     const Bytes&         data,
+                     const Bytes&         binary,
+                     const huff::Options& options)
+    {
+        huff::Options decodeOptions = options;
+
+        for (unsigned numThreads : { 1, 4 })
+        {
+            decodeOptions.numThreads = numThreads;
+
+            CAPTURE(numThreads);
+            CHECK(codec_files::Decode(name, binary, decodeOptions) == data);
+        }
+    }
+
+    huff::Options BlockOptions()
+    {
+        huff::Options options;
+        options.format    = huff::Format::BLOCK;
+        options.blockSize = BLOCK_MIN_SIZE;
+
+        return options;
+    }
+} // namespace
+
+TEST_CASE("Alfabeto de code points em textos com sequências de 2, 3 e 4 bytes")
+{
+    huff::Options options = BlockOptions();
+
+    // Cirílico, ideogramas CJK e emojis
+    struct Script
+    {
+            uint32_t first;
+            uint32_t count;
+    };
+
+    for (Script script : { Script { 0x410, 64 },
+                           Script { 0x4E00, 300 },
+                           Script { 0x1F600, 80 } })
+    {
+        Bytes data   = ScriptText(script.first, script.count, 3 * BLOCK_MIN_SIZE, 1);
+        Bytes binary = codec_files::Encode("code_points", data, options);
+
+        CAPTURE(script.first);
+
+        for (bool codePoints : CodePointBlocks(binary))
+            CHECK(codePoints);
+
+        CheckDecode("code_points", data, binary, options);
+    }
+}
+
+TEST_CASE("Sequência UTF-8 dividida entre dois blocos")
+{
+    huff::Options options = BlockOptions();
+
+    // Em um texto apenas com sequências de 3 bytes, o caractere que começa no byte
+    // BLOCK_MIN_SIZE - 2 termina no bloco seguinte. Os seus bytes são símbolos
+    // isolados nos dois blocos
+    Bytes data = ScriptText(0x4E00, 300, 2 * BLOCK_MIN_SIZE, 2);
+    REQUIRE(BLOCK_MIN_SIZE % 3 != 0);
+
+    Bytes binary = codec_files::Encode("code_points_split", data, options);
+
+    std::vector<bool> blocks = CodePointBlocks(binary);
+    REQUIRE(blocks.size() == 3);
+    CHECK(blocks[0]);
+    CHECK(blocks[1]);
+
+    CheckDecode("code_points_split", data, binary, options);
+
+    // Com um byte ASCII no início, o caractere de 4 bytes que começa no byte
+    // BLOCK_MIN_SIZE - 3 também é dividido
+    data = { 'x' };
+    Bytes emojis = ScriptText(0x1F600, 80, 2 * BLOCK_MIN_SIZE, 3);
+    data.insert(data.end(), emojis.begin(), emojis.end());
+
+    binary = codec_files::Encode("code_points_split", data, options);
+    CheckDecode("code_points_split", data, binary, options);
+}
+
+TEST_CASE("Alfabeto escolhido pelo tamanho do bloco")
+{
+    huff::Options options = BlockOptions();
+
+    // Texto ASCII não tem sequências de mais de um byte
+    Bytes ascii  = ScriptText('a', 26, BLOCK_MIN_SIZE / 2, 4);
+    Bytes binary = codec_files::Encode("code_points_ascii", ascii, options);
+
+    REQUIRE(CodePointBlocks(binary) == std::vector<bool> { false });
+
+    CheckDecode("code_points_ascii", ascii, binary, options);
+
+    // Em texto com sequências de 3 bytes, cada caractere é um único símbolo
+    Bytes text = ScriptText(0x4E00, 300, BLOCK_MIN_SIZE / 2, 5);
+    binary     = codec_files::Encode("code_points_text", text, options);
+
+    REQUIRE(CodePointBlocks(binary) == std::vector<bool> { true });
+
+    CheckDecode("code_points_text", text, binary, options);
+}
+
+TEST_CASE("Bytes inválidos em texto comprimido como binário")
+{
+    huff::Options options = BlockOptions();
+
+    Bytes data = ScriptText(0x4E00, 300, 2 * BLOCK_MIN_SIZE, 6);
+
+    // Continuações soltas, sequências interrompidas e bytes que nunca aparecem em
+    // UTF-8
+    std::mt19937 random(6);
+    for (unsigned char byte : { 0x80, 0xBF, 0xC3, 0xE2, 0xF0, 0xC0, 0xF5, 0xFF })
+    {
+        for (int i = 0; i < 50; i++)
+            data[random() % data.size()] = byte;
+    }
+
+    CHECK_THROWS_AS(codec_files::Encode("code_points_invalid", data, options),
+                    huffexcpt::IsNotUTF8Encoding);
+
+    options.binary = true;
+
+    Bytes binary = codec_files::Encode("code_points_invalid", data, options);
+
+    // Blocos binários usam o alfabeto de bytes
+    for (bool codePoints : CodePointBlocks(binary))
+        CHECK_FALSE(codePoints);
+
+    CheckDecode("code_points_invalid", data, binary, options);
+}
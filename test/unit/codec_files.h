@@ -0,0 +1,123 @@
+/*
+ * Filename: codec_files.h
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Funções auxiliares dos testes que comprimem e descomprimem arquivos por meio de
+ * Compress::Encode e Compress::Decode, em um diretório temporário
+ */
+
+#ifndef CODEC_FILES_H_
+#define CODEC_FILES_H_
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "huffman_code.h"
+#include "huffman_compress.h"
+
+namespace codec_files
+{
+    using Bytes = std::vector<unsigned char>;
+
+    // Diretório dos arquivos criados pelos testes
+    inline std::filesystem::path Directory()
+    {
+        std::filesystem::path directory =
+            std::filesystem::temp_directory_path() / "huff_unit_test";
+
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+
+    inline void WriteFile(const std::filesystem::path& path, const Bytes& data)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write((const char*)data.data(), data.size());
+    }
+
+    inline Bytes ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return Bytes(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * @brief Comprime `data` como o arquivo `name`.txt
+     * @param metrics Se não for nulo, recebe as medições da compressão
+     * @return Binário gerado
+     **/
+    inline Bytes Encode(const std::string&   name,
+                        const Bytes&         data,
+                        const huff::Options& options,
+                        huff::Metrics*       metrics = nullptr)
+    {
+        std::filesystem::path path = Directory() / (name + ".txt");
+        WriteFile(path, data);
+
+        huff::Compress compress(options);
+        compress.Encode(path.string());
+
+        if (metrics)
+            *metrics = compress.GetMetrics();
+
+        Bytes binary = ReadFile(path.string() + ".bin");
+        std::filesystem::remove(path);
+        std::filesystem::remove(path.string() + ".bin");
+
+        return binary;
+    }
+
+    /**
+     * @brief Descomprime `binary` como o binário de `name`.txt
+     * @return Arquivo restaurado
+     **/
+    inline Bytes
+    Decode(const std::string& name, const Bytes& binary, const huff::Options& options)
+    {
+        std::filesystem::path path         = Directory() / (name + ".txt.bin");
+        std::filesystem::path decompressed = Directory() / (name + "-decompressed.txt");
+        WriteFile(path, binary);
+
+        huff::Compress(options).Decode(path.string());
+
+        Bytes data = ReadFile(decompressed);
+        std::filesystem::remove(path);
+        std::filesystem::remove(decompressed);
+
+        return data;
+    }
+
+    /**
+     * @brief Comprimentos dos códigos de Huffman, calculados como no formato canônico
+     * @param frequencies Frequência de cada byte, indexada pelo byte
+     **/
+    inline std::vector<huff::Code>
+    CodeLengths(const std::vector<std::size_t>& frequencies)
+    {
+        std::vector<huff::SymbolWeight> sorted;
+        std::vector<huff::Code>         codes;
+
+        huff::ComputeCodeLengths(frequencies, sorted, codes);
+        return codes;
+    }
+
+    /**
+     * @brief Frequência de cada byte de `data`
+     **/
+    inline std::vector<std::size_t> Frequencies(const Bytes& data)
+    {
+        std::vector<std::size_t> frequencies(ALPHABET_SIZE, 0);
+
+        for (unsigned char byte : data)
+            frequencies[byte]++;
+
+        return frequencies;
+    }
+} // namespace codec_files
+
+#endif // CODEC_FILES_H_
@@ -0,0 +1,103 @@
+/*
+ * Filename: interleaved_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * No formato intercalado, os símbolos de cada bloco são distribuídos entre
+ * INTERLEAVED_STREAMS fluxos. A descompressão deve restaurar o arquivo mesmo quando
+ * algum fluxo fica vazio ou recebe um símbolo a menos que os outros
+ */
+
+#include <algorithm>
+#include <random>
+
+#include "codec_files.h"
+#include "doctest.h"
+
+namespace
+{
+    using codec_files::Bytes;
+
+    // O binário deve ter a assinatura do formato intercalado e o arquivo descomprimido
+    // com 1 e 4 threads deve ser o original
+    void CheckInterleaved(const std::string& name,
+                          const Bytes&       data,
+                          uint32_t           blockSize = BLOCK_MIN_SIZE)
+    {
+        huff::Options options;
+        options.format    = huff::Format::INTERLEAVED;
+        options.blockSize = blockSize;
+
+        Bytes binary = codec_files::Encode(name, data, options);
+
+        REQUIRE(binary.size() >= INTERLEAVED_SIGNATURE.size());
+        CHECK(std::equal(INTERLEAVED_SIGNATURE.begin(),
+                         INTERLEAVED_SIGNATURE.end(),
+                         binary.begin()));
+
+        for (unsigned numThreads : { 1, 4 })
+        {
+            options.numThreads = numThreads;
+
+            CAPTURE(numThreads);
+            CHECK(codec_files::Decode(name, binary, options) == data);
+        }
+    }
+
+    // Texto aleatório com as letras minúsculas
+    Bytes RandomText(std::size_t size, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        Bytes        data(size);
+
+        for (unsigned char& byte : data)
+            byte = 'a' + random() % 26;
+
+        return data;
+    }
+} // namespace
+
+TEST_CASE("Formato intercalado com menos símbolos que fluxos")
+{
+    // Com 1 a 3 símbolos, os últimos fluxos ficam vazios
+    for (std::size_t size = 1; size < huff::INTERLEAVED_STREAMS; size++)
+    {
+        CAPTURE(size);
+        CheckInterleaved("interleaved_small", RandomText(size, size));
+        CheckInterleaved("interleaved_small", Bytes(size, 'a'));
+    }
+
+    // Dois símbolos de 3 bytes cada, do alfabeto de code points
+    CheckInterleaved("interleaved_small", { 0xE4, 0xB8, 0x80, 0xE4, 0xB8, 0x81 });
+}
+
+TEST_CASE("Formato intercalado com a quantidade de símbolos fora dos múltiplos de 4")
+{
+    // Blocos de BLOCK_MIN_SIZE + 3 bytes, seguidos de um último bloco de 1 a 3 bytes
+    uint32_t blockSize = BLOCK_MIN_SIZE + 3;
+    REQUIRE(blockSize % huff::INTERLEAVED_STREAMS != 0);
+
+    for (std::size_t extra = 0; extra < huff::INTERLEAVED_STREAMS; extra++)
+    {
+        CAPTURE(extra);
+        CheckInterleaved("interleaved_remainder",
+                         RandomText(2 * blockSize + extra, 10 + extra),
+                         blockSize);
+    }
+
+    // Um bloco com uma quantidade de símbolos múltipla de 4 e um último bloco com 3
+    // símbolos
+    CheckInterleaved("interleaved_remainder", RandomText(BLOCK_MIN_SIZE + 3, 20));
+}
+
+TEST_CASE("Formato intercalado com um único símbolo no bloco")
+{
+    // O código do único símbolo tem um bit
+    CheckInterleaved("interleaved_single", Bytes(BLOCK_MIN_SIZE + 5, 'z'));
+
+    // Um bloco com vários símbolos seguido de um bloco com um único símbolo
+    Bytes data = RandomText(BLOCK_MIN_SIZE, 30);
+    data.insert(data.end(), BLOCK_MIN_SIZE / 2 + 1, 'q');
+
+    CheckInterleaved("interleaved_single", data);
+}
@@ -0,0 +1,173 @@
+/*
+ * Filename: limit_code_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Com o limite de comprimento, nenhum código gravado no binário pode ultrapassar
+ * maxCodeLength bits, os comprimentos devem formar um código prefixo e o custo
+ * informado nas medições deve ser exatamente o aumento do payload
+ */
+
+#include <algorithm>
+#include <random>
+
+#include "codec_files.h"
+#include "doctest.h"
+#include "huffman_compress_excpt.h"
+
+namespace
+{
+    using codec_files::Bytes;
+
+    // Arquivo com frequências de Fibonacci, cujos códigos de Huffman têm até
+    // `numSymbols` - 1 bits, e, opcionalmente, todos os outros bytes uma vez cada
+    Bytes FibonacciData(std::size_t numSymbols, bool allBytes)
+    {
+        Bytes       data;
+        std::size_t previous = 1;
+        std::size_t current  = 1;
+
+        for (std::size_t symbol = 0; symbol < numSymbols; symbol++)
+        {
+            data.insert(data.end(), previous, 'A' + symbol);
+
+            std::size_t next = previous + current;
+            previous         = current;
+            current          = next;
+        }
+
+        if (allBytes)
+        {
+            for (std::size_t byte = 0; byte < ALPHABET_SIZE; byte++)
+                if (byte < 'A' or byte >= 'A' + numSymbols)
+                    data.push_back(byte);
+        }
+
+        std::shuffle(data.begin(), data.end(), std::mt19937(numSymbols));
+        return data;
+    }
+
+    // Comprimentos gravados na tabela do formato canônico
+    std::vector<huff::Code> CanonicalCodeLengths(const Bytes& binary)
+    {
+        std::size_t offset =
+            CANONICAL_SIGNATURE.size() + HEADER_RESERVED_BYTES_AT_START;
+        REQUIRE(binary.size() > offset);
+
+        std::vector<huff::Code> codes;
+        huff::BitReader         reader(binary.data() + offset, binary.size() - offset);
+
+        REQUIRE(huff::ReadCodeLengths(reader, codes));
+        return codes;
+    }
+
+    // Comprime com o limite `maxCodeLength` e confere os códigos, o custo e a
+    // descompressão
+    void CheckLimit(const std::string& name, const Bytes& data, uint8_t maxCodeLength)
+    {
+        std::vector<std::size_t> frequencies = codec_files::Frequencies(data);
+        std::vector<huff::Code>  unlimited   = codec_files::CodeLengths(frequencies);
+
+        huff::Options options;
+        options.binary        = true;
+        options.maxCodeLength = maxCodeLength;
+
+        CAPTURE(int(maxCodeLength));
+
+        // Custo do limite, calculado a partir da tabela do formato canônico
+        uint64_t limitBits = 0;
+
+        for (huff::Format format : { huff::Format::CANONICAL, huff::Format::LEGACY })
+        {
+            options.format = format;
+
+            huff::Metrics metrics;
+            Bytes         binary = codec_files::Encode(name, data, options, &metrics);
+
+            CAPTURE(int(format));
+            CHECK(codec_files::Decode(name, binary, options) == data);
+
+            // No formato legado, a trie é reconstruída a partir dos mesmos comprimentos
+            if (format == huff::Format::LEGACY)
+            {
+                CHECK(metrics.limitBits == limitBits);
+                continue;
+            }
+
+            std::vector<huff::Code> limited = CanonicalCodeLengths(binary);
+
+            // Soma de Kraft multiplicada por 2^maxCodeLength
+            uint64_t kraft = 0;
+
+            for (std::size_t symbol = 0; symbol < ALPHABET_SIZE; symbol++)
+            {
+                CAPTURE(symbol);
+                CHECK(limited[symbol].length <= maxCodeLength);
+                CHECK((limited[symbol].length > 0) == (frequencies[symbol] > 0));
+
+                if (limited[symbol].length > 0)
+                    kraft += uint64_t(1) << (maxCodeLength - limited[symbol].length);
+            }
+
+            CHECK(kraft <= uint64_t(1) << maxCodeLength);
+
+            uint64_t limitedBits   = huff::EncodedBits(frequencies, limited);
+            uint64_t unlimitedBits = huff::EncodedBits(frequencies, unlimited);
+
+            limitBits = limitedBits - unlimitedBits;
+
+            CHECK(limitBits > 0);
+            CHECK(metrics.limitBits == limitBits);
+        }
+    }
+} // namespace
+
+TEST_CASE("Limite de comprimento em um histograma muito desigual")
+{
+    // Sem o limite, os códigos mais longos têm 29 bits
+    Bytes data = FibonacciData(30, false);
+    REQUIRE(huff::MaxCodeLength(
+                codec_files::CodeLengths(codec_files::Frequencies(data))) == 29);
+
+    for (uint8_t maxCodeLength : { 8, 12 })
+        CheckLimit("limit_code", data, maxCodeLength);
+}
+
+TEST_CASE("Limite de comprimento com todos os bytes presentes")
+{
+    // Com o limite de 8 bits, os 256 símbolos ocupam todos os códigos disponíveis
+    Bytes data = FibonacciData(30, true);
+
+    for (uint8_t maxCodeLength : { 8, 12 })
+        CheckLimit("limit_code_all_bytes", data, maxCodeLength);
+}
+
+TEST_CASE("Limite de comprimento que não precisa ser aplicado")
+{
+    Bytes data = FibonacciData(10, false);
+
+    huff::Options options;
+    options.format        = huff::Format::CANONICAL;
+    options.maxCodeLength = 12;
+
+    huff::Metrics metrics;
+    Bytes binary = codec_files::Encode("limit_code_unused", data, options, &metrics);
+
+    CHECK(metrics.limitBits == 0);
+    CHECK(huff::MaxCodeLength(CanonicalCodeLengths(binary)) == 9);
+    CHECK(codec_files::Decode("limit_code_unused", binary, options) == data);
+}
+
+TEST_CASE("Limite de comprimento menor que o necessário para o alfabeto")
+{
+    // 256 símbolos não cabem em códigos de 7 bits
+    huff::Options options;
+    options.format        = huff::Format::CANONICAL;
+    options.binary        = true;
+    options.maxCodeLength = 7;
+
+    CHECK_THROWS_AS(codec_files::Encode("limit_code_invalid",
+                                        FibonacciData(30, true),
+                                        options),
+                    huffexcpt::InvalidMaxCodeLength);
+}
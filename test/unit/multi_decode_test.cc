@@ -0,0 +1,284 @@
+/*
+ * Filename: multi_decode_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * O decodificador usa a tabela de vários símbolos apenas quando a média de símbolos
+ * por consulta atinge MULTI_DECODE_MIN_AVERAGE. Com ou sem ela, a saída deve ser a
+ * mesma da decodificação símbolo a símbolo
+ */
+
+#include <cmath>
+#include <random>
+#include <sstream>
+
+#include "bit_reader.h"
+#include "bit_writer.h"
+#include "doctest.h"
+#include "huffman_code.h"
+#include "huffman_compress.h"
+#include "huffman_decoder.h"
+
+namespace
+{
+    using Bytes = std::vector<unsigned char>;
+
+    // Códigos canônicos com os comprimentos `lengths`, atribuídos aos símbolos 0, 1,
+    // 2...
+    std::vector<huff::Code> CanonicalCodes(const std::vector<uint8_t>& lengths)
+    {
+        std::vector<huff::Code> codes(ALPHABET_SIZE);
+
+        for (std::size_t symbol = 0; symbol < lengths.size(); symbol++)
+            codes[symbol].length = lengths[symbol];
+
+        REQUIRE(huff::AssignCanonicalCodes(codes));
+        return codes;
+    }
+
+    // Média de símbolos por consulta da tabela de vários símbolos, calculada
+    // diretamente sobre os códigos: cada índice de DECODE_TABLE_BITS bits decodifica
+    // os códigos que cabem inteiros nele, até MULTI_DECODE_SYMBOLS
+    double ReferenceAverage(const std::vector<huff::Code>& codes)
+    {
+        std::size_t size       = std::size_t(1) << huff::DECODE_TABLE_BITS;
+        std::size_t numSymbols = 0;
+
+        for (std::size_t index = 0; index < size; index++)
+        {
+            uint8_t position = 0;
+            uint8_t count    = 0;
+            bool    found    = true;
+
+            while (found and count < huff::MULTI_DECODE_SYMBOLS)
+            {
+                found = false;
+
+                for (const huff::Code& code : codes)
+                {
+                    if (code.length == 0 or
+                        position + code.length > huff::DECODE_TABLE_BITS)
+                        continue;
+
+                    uint8_t shift = huff::DECODE_TABLE_BITS - position - code.length;
+
+                    if ((index >> shift & ((uint64_t(1) << code.length) - 1)) ==
+                        code.bits)
+                    {
+                        position += code.length;
+                        count++;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+
+            numSymbols += count;
+        }
+
+        return double(numSymbols) / size;
+    }
+
+    // Comprimentos de um código completo: `n` códigos de `k` bits e os demais de
+    // k + 1 bits. Com `tail`, e se houver símbolos suficientes, o último código de
+    // k + 1 bits é substituído por uma sequência de códigos cada vez mais longos, até
+    // 15 bits, que não cabem na tabela
+    std::vector<uint8_t> MixedLengths(uint8_t k, std::size_t n, bool tail)
+    {
+        std::vector<uint8_t> lengths(n, k);
+        lengths.insert(lengths.end(), 2 * ((std::size_t(1) << k) - n), k + 1);
+
+        if (tail and lengths.back() == k + 1 and
+            lengths.size() + 14 - k <= ALPHABET_SIZE)
+        {
+            lengths.pop_back();
+
+            for (uint8_t length = k + 2; length <= 15; length++)
+                lengths.push_back(length);
+
+            lengths.push_back(15);
+        }
+
+        return lengths;
+    }
+
+    // Símbolos sorteados com as probabilidades implícitas nos comprimentos
+    Bytes RandomSymbols(const std::vector<uint8_t>& lengths,
+                        std::size_t                 size,
+                        std::mt19937&               random)
+    {
+        std::vector<double> weights;
+
+        for (uint8_t length : lengths)
+            weights.push_back(std::ldexp(1.0, -length));
+
+        std::discrete_distribution<int> symbol(weights.begin(), weights.end());
+
+        Bytes data(size);
+        for (unsigned char& byte : data)
+            byte = symbol(random);
+
+        return data;
+    }
+
+    // Codifica `data` seguido de `trailing` bytes nulos. Com o preenchimento e os
+    // bytes nulos, a última entrada da tabela de vários símbolos consultada pode
+    // conter símbolos além do fim do payload
+    Bytes Encode(const std::vector<huff::Code>& codes,
+                 const Bytes&                   data,
+                 bool                           fillWithOnes,
+                 std::size_t                    trailing,
+                 uint64_t&                      numBits)
+    {
+        huff::BitWriter writer;
+        numBits = 0;
+
+        for (unsigned char byte : data)
+        {
+            writer.Write(codes[byte].bits, codes[byte].length);
+            numBits += codes[byte].length;
+        }
+
+        writer.AlignToByte(fillWithOnes);
+        writer.Flush();
+
+        Bytes binary(writer.GetData(), writer.GetData() + writer.GetSize());
+        binary.insert(binary.end(), trailing, 0);
+
+        return binary;
+    }
+
+    // Todas as formas de decodificação devem restaurar `data`
+    void CheckDecode(const huff::HuffmanDecoder&    decoder,
+                     const std::vector<huff::Code>& codes,
+                     const Bytes&                   data)
+    {
+        for (bool fillWithOnes : { true, false })
+        {
+            uint64_t numBits;
+            Bytes    binary = Encode(codes, data, fillWithOnes, 16, numBits);
+
+            CAPTURE(fillWithOnes);
+
+            // Símbolo a símbolo
+            Bytes           single(data.size());
+            huff::BitReader singleReader(binary.data(), binary.size());
+
+            for (unsigned char& byte : single)
+            {
+                singleReader.Refill();
+                byte = decoder.DecodeSymbol(singleReader);
+            }
+
+            CHECK(single == data);
+
+            // Em memória, com a quantidade de símbolos
+            Bytes           memory(data.size());
+            huff::BitReader memoryReader(binary.data(), binary.size());
+
+            CHECK(decoder.Decode(memoryReader, data.size(), memory.data()));
+            CHECK(memory == data);
+            CHECK(memoryReader.GetPosition() == numBits);
+
+            // Em uma stream, com a quantidade de bits
+            std::ostringstream stream;
+            huff::BitReader    streamReader(binary.data(), binary.size());
+            uint64_t           numSymbols;
+
+            CHECK(decoder.Decode(streamReader, numBits, stream, numSymbols));
+            CHECK(numSymbols == data.size());
+            CHECK(stream.str() == std::string(data.begin(), data.end()));
+
+            // Até uma posição do payload
+            Bytes           until;
+            huff::BitReader untilReader(binary.data(), binary.size());
+
+            CHECK(decoder.DecodeUntil(untilReader, numBits, until));
+            CHECK(until == data);
+        }
+    }
+} // namespace
+
+TEST_CASE("Tabela de vários símbolos usada a partir da média mínima")
+{
+    bool multi  = false;
+    bool single = false;
+
+    for (uint8_t k = 1; k <= 7; k++)
+    {
+        for (std::size_t n = 0; n < std::size_t(1) << k; n++)
+        {
+            for (bool tail : { false, true })
+            {
+                std::vector<huff::Code> codes =
+                    CanonicalCodes(MixedLengths(k, n, tail));
+
+                huff::HuffmanDecoder decoder;
+                REQUIRE(decoder.Build(huff::ListCodes(codes)));
+
+                double average = ReferenceAverage(codes);
+
+                CAPTURE(int(k));
+                CAPTURE(n);
+                CAPTURE(tail);
+                CAPTURE(average);
+                CHECK(decoder.IsMultiSymbol() ==
+                      (average >= huff::MULTI_DECODE_MIN_AVERAGE));
+
+                multi  = multi or decoder.IsMultiSymbol();
+                single = single or not decoder.IsMultiSymbol();
+            }
+        }
+    }
+
+    // As distribuições devem estar dos dois lados do limite
+    CHECK(multi);
+    CHECK(single);
+}
+
+TEST_CASE("Decodificação com e sem a tabela de vários símbolos")
+{
+    std::mt19937 random(1);
+
+    struct Distribution
+    {
+            uint8_t     k;
+            std::size_t n;
+            bool        tail;
+            bool        multi; // Se a tabela de vários símbolos deve ser usada
+    };
+
+    // Médias de 1,75 (o limite), 1,72, 1,76 e 1,73 (as duas últimas com códigos
+    // longos), e distribuições longe do limite
+    for (Distribution d : { Distribution { 5, 16, false, true },
+                            Distribution { 5, 15, false, false },
+                            Distribution { 5, 17, true, true },
+                            Distribution { 5, 16, true, false },
+                            Distribution { 2, 1, true, true },
+                            Distribution { 4, 0, false, true },
+                            Distribution { 6, 8, true, false },
+                            Distribution { 7, 100, false, false } })
+    {
+        std::vector<uint8_t>    lengths = MixedLengths(d.k, d.n, d.tail);
+        std::vector<huff::Code> codes   = CanonicalCodes(lengths);
+
+        huff::HuffmanDecoder decoder;
+        REQUIRE(decoder.Build(huff::ListCodes(codes)));
+
+        CAPTURE(int(d.k));
+        CAPTURE(d.n);
+        CAPTURE(d.tail);
+        CAPTURE(ReferenceAverage(codes));
+        REQUIRE(decoder.IsMultiSymbol() == d.multi);
+
+        // Todos os tamanhos até algumas recargas, para que o payload termine em cada
+        // posição de uma entrada de vários símbolos, e um payload maior
+        for (std::size_t size = 0; size <= 3 * huff::BIT_READER_MIN_BITS; size++)
+        {
+            CAPTURE(size);
+            CheckDecode(decoder, codes, RandomSymbols(lengths, size, random));
+        }
+
+        CheckDecode(decoder, codes, RandomSymbols(lengths, 100000, random));
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * Filename: parallel_encode_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * A compressão paralela dos formatos com uma única tabela deve gerar o mesmo
+ * binário, byte a byte, que a sequencial
+ */
+
+#include <cmath>
+#include <random>
+
+#include "codec_files.h"
+#include "doctest.h"
+
+namespace
+{
+    using codec_files::Bytes;
+
+    // Os binários gerados com 1 a 4 threads devem ser idênticos e restaurar o
+    // arquivo original
+    void CheckParallelEncode(const std::string& name,
+                             const Bytes&       data,
+                             huff::Format       format,
+                             bool               binary)
+    {
+        huff::Options options;
+        options.format     = format;
+        options.binary     = binary;
+        options.numThreads = 1;
+
+        Bytes sequential = codec_files::Encode(name, data, options);
+
+        for (unsigned numThreads = 2; numThreads <= 4; numThreads++)
+        {
+            options.numThreads = numThreads;
+
+            CAPTURE(numThreads);
+            CHECK(codec_files::Encode(name, data, options) == sequential);
+        }
+
+        CHECK(codec_files::Decode(name, sequential, options) == data);
+    }
+
+    // Texto com frequências decrescentes e alguns símbolos raros, de códigos longos
+    Bytes SkewedText(std::size_t size, unsigned seed)
+    {
+        std::vector<double> weights;
+
+        for (int i = 0; i < 24; i++)
+            weights.push_back(std::pow(0.8, i));
+
+        for (int i = 0; i < 4; i++)
+            weights.push_back(1e-5);
+
+        std::mt19937                    random(seed);
+        std::discrete_distribution<int> symbol(weights.begin(), weights.end());
+
+        Bytes data(size);
+        for (unsigned char& byte : data)
+        {
+            int s = symbol(random);
+            byte  = s < 24 ? 'A' + s : 'a' + s - 24;
+        }
+
+        return data;
+    }
+} // namespace
+
+TEST_CASE("Compressão paralela idêntica à sequencial")
+{
+    // Uma parte e alguns bytes, e duas partes e alguns bytes, que com duas threads
+    // são codificadas em duas rodadas
+    for (std::size_t size : { FREQUENCIES_CHUNK_SIZE + 12345,
+                              2 * FREQUENCIES_CHUNK_SIZE + 777 })
+    {
+        Bytes data = SkewedText(size, size);
+
+        CAPTURE(size);
+        CheckParallelEncode("parallel_text", data, huff::Format::LEGACY, false);
+        CheckParallelEncode("parallel_text", data, huff::Format::CANONICAL, false);
+    }
+}
+
+TEST_CASE("Compressão paralela de bytes aleatórios")
+{
+    std::mt19937 random(1);
+    Bytes        data(FREQUENCIES_CHUNK_SIZE + 4321);
+
+    for (unsigned char& byte : data)
+        byte = random();
+
+    CheckParallelEncode("parallel_binary", data, huff::Format::LEGACY, true);
+    CheckParallelEncode("parallel_binary", data, huff::Format::CANONICAL, true);
+}
+
+TEST_CASE("Compressão paralela com a divisão das partes no meio de um byte")
+{
+    Bytes data = SkewedText(FREQUENCIES_CHUNK_SIZE + 999, 7);
+
+    std::vector<std::size_t> frequencies = codec_files::Frequencies(data);
+    std::vector<huff::Code>  codes       = codec_files::CodeLengths(frequencies);
+
+    // Quantidade de bits da primeira parte
+    auto firstChunkBits = [&]()
+    {
+        uint64_t bits = 0;
+        for (std::size_t i = 0; i < FREQUENCIES_CHUNK_SIZE; i++)
+            bits += codes[data[i]].length;
+
+        return bits;
+    };
+
+    // Posição do primeiro símbolo raro
+    auto findRare = [&]()
+    {
+        std::size_t i = 0;
+        while (data[i] >= 'A' and data[i] <= 'Z')
+            i++;
+
+        return i;
+    };
+
+    // Os últimos bits da primeira parte e os primeiros da segunda são de códigos
+    // longos. As trocas mantêm as frequências e, portanto, os códigos
+    std::swap(data[FREQUENCIES_CHUNK_SIZE - 1], data[findRare()]);
+    std::swap(data[FREQUENCIES_CHUNK_SIZE], data[findRare()]);
+
+    // Se a primeira parte terminar no fim de um byte, troca um símbolo dela por um da
+    // segunda com código de outro comprimento
+    for (std::size_t i = 0; firstChunkBits() % BYTE_SIZE == 0; i++)
+    {
+        std::size_t j = FREQUENCIES_CHUNK_SIZE + 1 + i;
+
+        if ((codes[data[i]].length - codes[data[j]].length) % BYTE_SIZE != 0)
+            std::swap(data[i], data[j]);
+    }
+
+    REQUIRE(codes[data[FREQUENCIES_CHUNK_SIZE - 1]].length >= 12);
+    REQUIRE(codes[data[FREQUENCIES_CHUNK_SIZE]].length >= 12);
+    REQUIRE(firstChunkBits() % BYTE_SIZE != 0);
+
+    CheckParallelEncode("parallel_boundary", data, huff::Format::CANONICAL, false);
+}
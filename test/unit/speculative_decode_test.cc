@@ -0,0 +1,161 @@
+/*
+ * Filename: speculative_decode_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * A descompressão paralela dos formatos com uma única tabela deve restaurar o mesmo
+ * arquivo que a sequencial, inclusive quando a decodificação especulativa de uma
+ * parte nunca alcança a sequencial
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "codec_files.h"
+#include "doctest.h"
+
+namespace
+{
+    using codec_files::Bytes;
+
+    // Início da segunda parte do payload, em bits
+    constexpr uint64_t CHUNK_BITS = SPECULATIVE_CHUNK_SIZE * BYTE_SIZE;
+
+    // Arquivo com `counts[i]` cópias de `symbols[i]`, em ordem aleatória
+    Bytes Shuffled(const std::vector<unsigned char>& symbols,
+                   const std::vector<std::size_t>&   counts,
+                   unsigned                          seed)
+    {
+        Bytes data;
+
+        for (std::size_t i = 0; i < symbols.size(); i++)
+            data.insert(data.end(), counts[i], symbols[i]);
+
+        std::shuffle(data.begin(), data.end(), std::mt19937(seed));
+        return data;
+    }
+
+    // O arquivo descomprimido com 1 a 4 threads deve ser o original
+    void CheckParallelDecode(const std::string& name,
+                             const Bytes&       data,
+                             huff::Format       format)
+    {
+        huff::Options options;
+        options.format     = format;
+        options.numThreads = 1;
+
+        Bytes binary = codec_files::Encode(name, data, options);
+
+        // O payload deve ter mais de uma parte
+        REQUIRE(binary.size() > SPECULATIVE_CHUNK_SIZE);
+
+        for (unsigned numThreads = 1; numThreads <= 4; numThreads++)
+        {
+            options.numThreads = numThreads;
+
+            CAPTURE(numThreads);
+            CHECK(codec_files::Decode(name, binary, options) == data);
+        }
+    }
+} // namespace
+
+TEST_CASE("Decodificação paralela de um payload pouco maior que uma parte")
+{
+    // Texto com frequências decrescentes, cujos códigos se sincronizam rapidamente
+    std::vector<unsigned char> symbols;
+    std::vector<std::size_t>   counts;
+
+    for (int i = 0; i < 26; i++)
+    {
+        symbols.push_back('a' + i);
+        counts.push_back(1 + std::size_t(1050000 * std::pow(0.8, i)));
+    }
+
+    Bytes data = Shuffled(symbols, counts, 1);
+
+    CheckParallelDecode("speculative_text", data, huff::Format::LEGACY);
+    CheckParallelDecode("speculative_text", data, huff::Format::CANONICAL);
+}
+
+TEST_CASE("Decodificação paralela com o fim da parte no meio de um código longo")
+{
+    std::vector<unsigned char> symbols;
+    std::vector<std::size_t>   counts;
+
+    for (int i = 0; i < 24; i++)
+    {
+        symbols.push_back('A' + i);
+        counts.push_back(1 + std::size_t(1050000 * std::pow(0.8, i)));
+    }
+
+    // Símbolos raros, com os códigos mais longos
+    for (unsigned char symbol : { 'a', 'b', 'c', 'd' })
+    {
+        symbols.push_back(symbol);
+        counts.push_back(20);
+    }
+
+    Bytes data = Shuffled(symbols, counts, 2);
+
+    std::vector<std::size_t> frequencies = codec_files::Frequencies(data);
+    std::vector<huff::Code>  codes       = codec_files::CodeLengths(frequencies);
+
+    REQUIRE(huff::EncodedBits(frequencies, codes) > CHUNK_BITS);
+
+    // Símbolo cujo código contém o início da segunda parte
+    uint64_t    bit = 0;
+    std::size_t p   = 0;
+
+    while (bit + codes[data[p]].length <= CHUNK_BITS)
+        bit += codes[data[p++]].length;
+
+    // Se o código começa exatamente no início da parte, usa o anterior
+    if (bit == CHUNK_BITS)
+        bit -= codes[data[--p]].length;
+
+    // Troca o símbolo por um raro que aparece depois, o que preserva as frequências
+    // e a posição do início do código
+    std::size_t q = p + 1;
+    while (q < data.size() and data[q] >= 'A' and data[q] <= 'Z')
+        q++;
+
+    REQUIRE(q < data.size());
+    std::swap(data[p], data[q]);
+
+    REQUIRE(codes[data[p]].length >= 12);
+    REQUIRE(bit < CHUNK_BITS);
+    REQUIRE(bit + codes[data[p]].length > CHUNK_BITS);
+
+    CheckParallelDecode("speculative_long_code", data, huff::Format::CANONICAL);
+}
+
+TEST_CASE("Decodificação paralela sem sincronização entre as partes")
+{
+    // Frequências 1/8, 1/64 e 1/512 resultam em códigos de 3, 6 e 9 bits. Todos os
+    // códigos começam em posições múltiplas de 3, e a segunda parte começa no bit
+    // 2^24, que não é. A decodificação especulativa nunca passa pelo início de um
+    // código, e a parte é decodificada novamente a partir do fim da anterior
+    std::vector<unsigned char> symbols;
+    std::vector<std::size_t>   counts;
+    constexpr std::size_t      unit = 10000;
+
+    for (int i = 0; i < 22; i++)
+    {
+        symbols.push_back('a' + i);
+        counts.push_back(i < 7 ? 64 * unit : i < 14 ? 8 * unit : unit);
+    }
+
+    Bytes data = Shuffled(symbols, counts, 3);
+
+    std::vector<huff::Code> codes =
+        codec_files::CodeLengths(codec_files::Frequencies(data));
+
+    for (unsigned char symbol : symbols)
+        REQUIRE(codes[symbol].length % 3 == 0);
+
+    REQUIRE(CHUNK_BITS % 3 != 0);
+
+    CheckParallelDecode("speculative_no_sync", data, huff::Format::LEGACY);
+    CheckParallelDecode("speculative_no_sync", data, huff::Format::CANONICAL);
+}
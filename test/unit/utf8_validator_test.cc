@@ -0,0 +1,296 @@
+/*
+ * Filename: utf8_validator_test.cc
+ * Created on: October 17, 2026
+ * Author: Lucas Araújo <araujolucas@dcc.ufmg.br>
+ *
+ * Compara a validação UTF-8 (vetorial, quando o processador permite, e em partes)
+ * com um decodificador escalar simples, que calcula o valor de cada sequência
+ */
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+#include "utf8_validator.h"
+
+namespace
+{
+    using Bytes = std::vector<unsigned char>;
+
+    // Início da primeira sequência inválida ou incompleta, ou UTF8_VALID
+    uint64_t ReferenceInvalidUTF8(const Bytes& data)
+    {
+        std::size_t i = 0;
+
+        while (i < data.size())
+        {
+            unsigned char lead = data[i];
+            std::size_t   length;
+            uint32_t      value;
+            uint32_t      minimum;
+
+            if (lead < 0x80)
+            {
+                i++;
+                continue;
+            }
+
+            if ((lead & 0xE0) == 0xC0)
+            {
+                length  = 2;
+                value   = lead & 0x1F;
+                minimum = 0x80;
+            }
+            else if ((lead & 0xF0) == 0xE0)
+            {
+                length  = 3;
+                value   = lead & 0x0F;
+                minimum = 0x800;
+            }
+            else if ((lead & 0xF8) == 0xF0)
+            {
+                length  = 4;
+                value   = lead & 0x07;
+                minimum = 0x10000;
+            }
+            else
+                return i;
+
+            if (i + length > data.size())
+                return i;
+
+            for (std::size_t k = 1; k < length; k++)
+            {
+                if ((data[i + k] & 0xC0) != 0x80)
+                    return i;
+
+                value = value << 6 | (data[i + k] & 0x3F);
+            }
+
+            if (value < minimum or value > 0x10FFFF or
+                (value >= 0xD800 and value <= 0xDFFF))
+                return i;
+
+            i += length;
+        }
+
+        return huff::UTF8_VALID;
+    }
+
+    // Codificação UTF-8 de um code point válido
+    void AppendCodePoint(Bytes& data, uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+            data.push_back(codePoint);
+        else if (codePoint < 0x800)
+        {
+            data.push_back(0xC0 | codePoint >> 6);
+            data.push_back(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            data.push_back(0xE0 | codePoint >> 12);
+            data.push_back(0x80 | (codePoint >> 6 & 0x3F));
+            data.push_back(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            data.push_back(0xF0 | codePoint >> 18);
+            data.push_back(0x80 | (codePoint >> 12 & 0x3F));
+            data.push_back(0x80 | (codePoint >> 6 & 0x3F));
+            data.push_back(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    // Texto válido com sequências de todos os tamanhos
+    Bytes ValidText(std::mt19937& random, std::size_t numCodePoints)
+    {
+        std::uniform_int_distribution<int> length(1, 4);
+        Bytes                              data;
+
+        for (std::size_t i = 0; i < numCodePoints; i++)
+        {
+            uint32_t codePoint;
+
+            switch (length(random))
+            {
+                case 1:
+                    codePoint = random() % 0x80;
+                    break;
+                case 2:
+                    codePoint = 0x80 + random() % (0x800 - 0x80);
+                    break;
+                case 3:
+                    codePoint = 0x800 + random() % (0x10000 - 0x800);
+                    if (codePoint >= 0xD800 and codePoint <= 0xDFFF)
+                        codePoint -= 0x800;
+                    break;
+                default:
+                    codePoint = 0x10000 + random() % (0x110000 - 0x10000);
+                    break;
+            }
+
+            AppendCodePoint(data, codePoint);
+        }
+
+        return data;
+    }
+
+    // Sequências inválidas, inseridas em um texto válido
+    const std::vector<Bytes> INVALID_SEQUENCES = {
+        // Sequências interrompidas
+        { 0xC3 },
+        { 0xE2, 0x82 },
+        { 0xF0, 0x9F, 0x98 },
+        { 0xC3, 0x41 },
+        { 0xE2, 0x41, 0x82 },
+        // Continuações soltas
+        { 0x80 },
+        { 0xBF },
+        { 0xC3, 0xA9, 0xA9 },
+        // Codificações não mínimas
+        { 0xC0, 0x80 },
+        { 0xC1, 0xBF },
+        { 0xE0, 0x80, 0x80 },
+        { 0xE0, 0x9F, 0xBF },
+        { 0xF0, 0x80, 0x80, 0x80 },
+        { 0xF0, 0x8F, 0xBF, 0xBF },
+        // Surrogates
+        { 0xED, 0xA0, 0x80 },
+        { 0xED, 0xBF, 0xBF },
+        // Valores acima de U+10FFFF e bytes que nunca aparecem
+        { 0xF4, 0x90, 0x80, 0x80 },
+        { 0xF5, 0x80, 0x80, 0x80 },
+        { 0xF8, 0x88, 0x80, 0x80, 0x80 },
+        { 0xFE },
+        { 0xFF },
+    };
+
+    // Validação em partes, com as divisões em `cuts`
+    uint64_t ChunkedInvalidUTF8(const Bytes& data, const std::vector<std::size_t>& cuts)
+    {
+        huff::UTF8Validator validator;
+        std::size_t         begin = 0;
+
+        for (std::size_t i = 0; i <= cuts.size(); i++)
+        {
+            std::size_t end = i < cuts.size() ? cuts[i] : data.size();
+
+            // Cada parte é validada isoladamente e unida às anteriores, como na
+            // contagem paralela das frequências
+            huff::UTF8Validator part;
+            part.Update(data.data() + begin, end - begin);
+            validator.Append(part);
+
+            begin = end;
+        }
+
+        validator.Finish();
+        return validator.GetErrorOffset();
+    }
+} // namespace
+
+TEST_CASE("FindInvalidUTF8 aceita texto válido")
+{
+    std::mt19937 random(1);
+
+    for (std::size_t numCodePoints : { 0, 1, 7, 31, 100, 1000, 10000 })
+    {
+        Bytes data = ValidText(random, numCodePoints);
+        CHECK(huff::FindInvalidUTF8(data.data(), data.size()) == huff::UTF8_VALID);
+    }
+}
+
+TEST_CASE("FindInvalidUTF8 encontra sequências inválidas em qualquer posição")
+{
+    std::mt19937 random(2);
+    Bytes        text = ValidText(random, 60);
+
+    // As posições cobrem o início, o meio e o fim dos vetores de 16 e 32 bytes
+    for (const Bytes& invalid : INVALID_SEQUENCES)
+    {
+        for (std::size_t position = 0; position <= text.size(); position++)
+        {
+            Bytes data(text.begin(), text.begin() + position);
+            data.insert(data.end(), invalid.begin(), invalid.end());
+            data.insert(data.end(), text.begin() + position, text.end());
+
+            CAPTURE(position);
+            CHECK(huff::FindInvalidUTF8(data.data(), data.size()) ==
+                  ReferenceInvalidUTF8(data));
+        }
+    }
+}
+
+TEST_CASE("FindInvalidUTF8 concorda com o decodificador escalar em bytes aleatórios")
+{
+    std::mt19937 random(3);
+
+    for (int iteration = 0; iteration < 2000; iteration++)
+    {
+        // Texto válido com poucos bytes trocados por valores aleatórios
+        Bytes data = ValidText(random, 1 + random() % 200);
+
+        for (std::size_t k = random() % 3; k > 0; k--)
+            data[random() % data.size()] = random();
+
+        CAPTURE(iteration);
+        CHECK(huff::FindInvalidUTF8(data.data(), data.size()) ==
+              ReferenceInvalidUTF8(data));
+    }
+}
+
+TEST_CASE("UTF8Validator une sequências divididas entre partes")
+{
+    std::mt19937 random(4);
+    Bytes        text = ValidText(random, 40);
+
+    std::vector<Bytes> inputs = { text };
+
+    for (const Bytes& invalid : INVALID_SEQUENCES)
+    {
+        Bytes data(text.begin(), text.begin() + text.size() / 2);
+        data.insert(data.end(), invalid.begin(), invalid.end());
+        data.insert(data.end(), text.begin() + text.size() / 2, text.end());
+        inputs.push_back(data);
+
+        // A sequência inválida também no início e no fim do arquivo
+        data.assign(invalid.begin(), invalid.end());
+        data.insert(data.end(), text.begin(), text.end());
+        inputs.push_back(data);
+
+        data.assign(text.begin(), text.end());
+        data.insert(data.end(), invalid.begin(), invalid.end());
+        inputs.push_back(data);
+    }
+
+    for (const Bytes& data : inputs)
+    {
+        uint64_t expected = ReferenceInvalidUTF8(data);
+
+        CHECK(ChunkedInvalidUTF8(data, {}) == expected);
+
+        // Uma divisão em cada posição
+        for (std::size_t cut = 0; cut <= data.size(); cut++)
+        {
+            CAPTURE(cut);
+            CHECK(ChunkedInvalidUTF8(data, { cut }) == expected);
+        }
+
+        // Partes de um a quatro bytes, que dividem as sequências de todas as formas
+        for (std::size_t step = 1; step <= 4; step++)
+        {
+            for (std::size_t first = 0; first < step; first++)
+            {
+                std::vector<std::size_t> cuts;
+                for (std::size_t cut = first; cut <= data.size(); cut += step)
+                    cuts.push_back(cut);
+
+                CAPTURE(step);
+                CAPTURE(first);
+                CHECK(ChunkedInvalidUTF8(data, cuts) == expected);
+            }
+        }
+    }
+}